@@ -11,11 +11,27 @@
 #include <cmath>
 #include <sstream>
 #include <type_traits>
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 extern "C" {
 #include <jpeglib.h>
+#include <jerror.h>
 }
 
+// Les instructions SIMD x86 sont choisies à l'exécution, selon le processeur
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define IMAGE_SIMD_X86
+#include <immintrin.h>
+#endif
+
 const char* const identifier = "david_a";
 const char* const informations = "Beaucoup de méthodes dépréciées, car j'ai fait des méthodes soit plus sécurisées,"
                                  "soit avec moins de paramètres et une meilleure couche d'abstraction\n"
@@ -38,8 +54,10 @@ using invalidSizeArray = std::invalid_argument;
 using invalidFormat = std::invalid_argument;
 using invalidLength = std::invalid_argument;
 using invalidColorMapType = std::invalid_argument;
+using invalidSizeRepresentationPixel = std::invalid_argument;
 using invalidCoordinateX = std::invalid_argument;
 using invalidCoordinateY = std::invalid_argument;
+using invalidJPEG = std::runtime_error;
 
 using invalidShade = std::invalid_argument;
 using invalidColor = std::invalid_argument;
@@ -58,10 +76,13 @@ namespace imageUtils {
     // TODO Documenter ou raprocher de l'utilisation
     using invalidEnumTYPE = std::invalid_argument;
 
-    // aka 65535
+    // aka 65535, or 4294967295 with IMAGE_LARGE_DIMENSIONS
     constexpr static auto maxWidth = std::numeric_limits<Width>::max();
     constexpr static auto maxHeight = std::numeric_limits<Height>::max();
 
+    // Les formats TARGA et Maison2 codent la largeur et la hauteur sur deux octets
+    constexpr static auto maxFileDimension = std::numeric_limits<uint16_t>::max();
+
     // aka 255
     constexpr static auto maxIntensity = std::numeric_limits<Shade>::max();
 
@@ -128,8 +149,267 @@ namespace imageUtils {
         }
     }
 
-    static bool isEndOfLine( const intmax_t pos, const intmax_t width, const intmax_t limit ) {
-        return ( 0 == ( pos % width ) ) || ( 0 == ( pos % limit ) );
+    /// All functions contained in this namespace use SIMD instructions, if the processor has them
+    namespace SIMD {
+        /// Mask of equalNextPixelsSSE2, when the five pixels are equal to their next pixel
+        constexpr unsigned allEqualNextPixels = 0b1'001'001'001'001;
+
+#ifdef IMAGE_SIMD_X86
+        /// \returns true if the processor can execute SSSE3 instructions
+        static bool hasSSSE3() {
+            static const bool supported = ( 0 != __builtin_cpu_supports( "ssse3" ) );
+            return supported;
+        }
+
+        /// Exchange the first and the third shade of pixels, five pixels at each step
+        /// Each step reads and writes 16 bytes, the 16th byte is written again by the next step
+        /// \returns The number of converted pixels, the remaining pixels are not converted
+        __attribute__((target("ssse3")))
+        static size_t swapRedBlueSSSE3( const Shade* const src, Shade* const dst, const size_t count ) {
+            const auto mask = _mm_setr_epi8( 2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15 );
+
+            size_t i = 0;
+            // On s'arrête avant de lire ou d'écrire au-delà des count pixels
+            for ( ; ( i + 6 ) <= count; i += 5 ) {
+                const auto pixels = _mm_loadu_si128( reinterpret_cast<const __m128i*>(src + ( i * 3 )) );
+                _mm_storeu_si128( reinterpret_cast<__m128i*>(dst + ( i * 3 )), _mm_shuffle_epi8( pixels, mask ) );
+            }
+
+            return i;
+        }
+
+        /// Interleave three planes of shades in pixels of three shades, sixteen pixels at each step
+        /// \returns The number of interleaved pixels, the remaining pixels are not interleaved
+        __attribute__((target("ssse3")))
+        static size_t interleavePlanesSSSE3( const Shade* const first, const Shade* const second, const Shade* const third,
+                                             Shade* const dst, const size_t count ) {
+            // Pour chaque vecteur de sortie, la position de chaque octet dans son plan, -1 met l'octet à 0
+            const __m128i masks[3][3] = {
+                    { _mm_setr_epi8( 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5 ),
+                      _mm_setr_epi8( -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1 ),
+                      _mm_setr_epi8( -1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1 ) },
+                    { _mm_setr_epi8( -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1 ),
+                      _mm_setr_epi8( 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10 ),
+                      _mm_setr_epi8( -1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1 ) },
+                    { _mm_setr_epi8( -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1 ),
+                      _mm_setr_epi8( -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1 ),
+                      _mm_setr_epi8( 10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15 ) }
+            };
+
+            size_t i = 0;
+            for ( ; ( i + 16 ) <= count; i += 16 ) {
+                const auto a = _mm_loadu_si128( reinterpret_cast<const __m128i*>(first + i) );
+                const auto b = _mm_loadu_si128( reinterpret_cast<const __m128i*>(second + i) );
+                const auto c = _mm_loadu_si128( reinterpret_cast<const __m128i*>(third + i) );
+
+                for ( size_t v = 0; v < 3; ++v ) {
+                    const auto pixels = _mm_or_si128( _mm_or_si128( _mm_shuffle_epi8( a, masks[v][0] ),
+                                                                    _mm_shuffle_epi8( b, masks[v][1] ) ),
+                                                      _mm_shuffle_epi8( c, masks[v][2] ) );
+                    _mm_storeu_si128( reinterpret_cast<__m128i*>(dst + ( i * 3 ) + ( v * 16 )), pixels );
+                }
+            }
+
+            return i;
+        }
+
+        /// Split pixels of three shades in three planes of shades, sixteen pixels at each step
+        /// \returns The number of split pixels, the remaining pixels are not split
+        __attribute__((target("ssse3")))
+        static size_t deinterleavePlanesSSSE3( const Shade* const src, Shade* const first, Shade* const second,
+                                               Shade* const third, const size_t count ) {
+            // Pour chaque plan, la position de chaque octet dans les trois vecteurs d'entrée, -1 met l'octet à 0
+            const __m128i masks[3][3] = {
+                    { _mm_setr_epi8( 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 ),
+                      _mm_setr_epi8( -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1 ),
+                      _mm_setr_epi8( -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13 ) },
+                    { _mm_setr_epi8( 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 ),
+                      _mm_setr_epi8( -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1 ),
+                      _mm_setr_epi8( -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14 ) },
+                    { _mm_setr_epi8( 2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 ),
+                      _mm_setr_epi8( -1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1 ),
+                      _mm_setr_epi8( -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15 ) }
+            };
+            Shade* const planes[3] = { first, second, third };
+
+            size_t i = 0;
+            for ( ; ( i + 16 ) <= count; i += 16 ) {
+                const auto a = _mm_loadu_si128( reinterpret_cast<const __m128i*>(src + ( i * 3 )) );
+                const auto b = _mm_loadu_si128( reinterpret_cast<const __m128i*>(src + ( i * 3 ) + 16) );
+                const auto c = _mm_loadu_si128( reinterpret_cast<const __m128i*>(src + ( i * 3 ) + 32) );
+
+                for ( size_t p = 0; p < 3; ++p ) {
+                    const auto shades = _mm_or_si128( _mm_or_si128( _mm_shuffle_epi8( a, masks[p][0] ),
+                                                                    _mm_shuffle_epi8( b, masks[p][1] ) ),
+                                                      _mm_shuffle_epi8( c, masks[p][2] ) );
+                    _mm_storeu_si128( reinterpret_cast<__m128i*>(planes[p] + i), shades );
+                }
+            }
+
+            return i;
+        }
+#endif
+
+#ifdef __SSE2__
+        /// Compute the greatest of the first shades in maximum, sixty-four shades at each step, then sixteen
+        /// \returns The number of read shades, the remaining shades are not read
+        static size_t maxShadeSSE2( const Shade* const shades, const size_t count, Shade& maximum ) {
+            auto greatest = _mm_set1_epi8( static_cast<char>(maximum) );
+
+            size_t i = 0;
+            for ( ; ( i + 64 ) <= count; i += 64 ) {
+                const auto a = _mm_loadu_si128( reinterpret_cast<const __m128i*>(shades + i) );
+                const auto b = _mm_loadu_si128( reinterpret_cast<const __m128i*>(shades + i + 16) );
+                const auto c = _mm_loadu_si128( reinterpret_cast<const __m128i*>(shades + i + 32) );
+                const auto d = _mm_loadu_si128( reinterpret_cast<const __m128i*>(shades + i + 48) );
+                greatest = _mm_max_epu8( greatest, _mm_max_epu8( _mm_max_epu8( a, b ), _mm_max_epu8( c, d ) ) );
+            }
+
+            for ( ; ( i + 16 ) <= count; i += 16 ) {
+                greatest = _mm_max_epu8( greatest, _mm_loadu_si128( reinterpret_cast<const __m128i*>(shades + i) ) );
+            }
+
+            // Le maximum des seize octets est replié sur le premier octet
+            greatest = _mm_max_epu8( greatest, _mm_srli_si128( greatest, 8 ) );
+            greatest = _mm_max_epu8( greatest, _mm_srli_si128( greatest, 4 ) );
+            greatest = _mm_max_epu8( greatest, _mm_srli_si128( greatest, 2 ) );
+            greatest = _mm_max_epu8( greatest, _mm_srli_si128( greatest, 1 ) );
+            maximum = static_cast<Shade>( _mm_cvtsi128_si32( greatest ) & 0xFF );
+
+            return i;
+        }
+
+        /// Compare five pixels of three shades with their next pixel, with one comparison of 16 bytes
+        /// \pre 19 bytes can be read from pixels, the second load reads the bytes [3; 19[
+        /// \returns A mask where the bit 3q is set if the pixel q is equal to the pixel q+1, for q in [0;5[
+        static unsigned equalNextPixelsSSE2( const Shade* const pixels ) {
+            const auto current = _mm_loadu_si128( reinterpret_cast<const __m128i*>(pixels) );
+            const auto next = _mm_loadu_si128( reinterpret_cast<const __m128i*>(pixels + 3) );
+            const auto equal = static_cast<unsigned>( _mm_movemask_epi8( _mm_cmpeq_epi8( current, next ) ) );
+
+            // Un pixel est égal au suivant si ses trois nuances sont égales
+            return equal & ( equal >> 1 ) & ( equal >> 2 ) & allEqualNextPixels;
+        }
+#endif
+    }
+
+    /// \returns true if the pixel of three shades at p is equal to the next pixel
+    static bool equalNextPixel( const Shade* const p ) {
+        return ( p[0] == p[3] ) && ( p[1] == p[4] ) && ( p[2] == p[5] );
+    }
+
+    /// \returns The number of pixels of three shades equal to the first one, from the first one, up to count
+    /// \pre count > 0
+    static size_t runLength( const Shade* const pixels, const size_t count ) {
+        size_t q = 0;
+
+        while ( ( q + 1 ) < count ) {
+#ifdef __SSE2__
+            // Sept pixels au moins : la seconde lecture de 16 octets reste dans la ligne
+            if ( ( q + 7 ) <= count ) {
+                const auto mask = SIMD::equalNextPixelsSSE2( pixels + ( q * 3 ) );
+
+                if ( SIMD::allEqualNextPixels == mask ) {
+                    q += 5;
+                    continue;
+                }
+
+                // Le premier bit absent donne le premier pixel différent de son suivant
+                q += static_cast<size_t>( __builtin_ctz( ~mask & SIMD::allEqualNextPixels ) ) / 3;
+                break;
+            }
+#endif
+            if ( !equalNextPixel( pixels + ( q * 3 ) ) ) {
+                break;
+            }
+            ++q;
+        }
+
+        return std::min( q + 1, count );
+    }
+
+    /// \returns The number of pixels of three shades before the first pixel equal to its next one, up to count
+    static size_t literalLength( const Shade* const pixels, const size_t count ) {
+        size_t k = 0;
+
+        while ( ( k + 1 ) < count ) {
+#ifdef __SSE2__
+            // Sept pixels au moins : la seconde lecture de 16 octets reste dans la ligne
+            if ( ( k + 7 ) <= count ) {
+                const auto mask = SIMD::equalNextPixelsSSE2( pixels + ( k * 3 ) );
+
+                if ( 0 != mask ) {
+                    return k + ( static_cast<size_t>( __builtin_ctz( mask ) ) / 3 );
+                }
+
+                k += 5;
+                continue;
+            }
+#endif
+            if ( equalNextPixel( pixels + ( k * 3 ) ) ) {
+                return k;
+            }
+            ++k;
+        }
+
+        return count;
+    }
+
+    /// Copy count pixels of three shades from src to dst, by exchanging the first and the third shade
+    /// So BGR pixels become RGB pixels, and RGB pixels become BGR pixels
+    /// \pre src and dst can be the same memory, but they can't overlap partially
+    static void swapRedBlue( const Shade* const src, Shade* const dst, const size_t count ) {
+        size_t i = 0;
+
+#ifdef IMAGE_SIMD_X86
+        if ( SIMD::hasSSSE3() ) {
+            i = SIMD::swapRedBlueSSSE3( src, dst, count );
+        }
+#endif
+
+        for ( ; i < count; ++i ) {
+            const Shade first = src[( i * 3 )];
+            dst[( i * 3 ) + 1] = src[( i * 3 ) + 1];
+            dst[( i * 3 )] = src[( i * 3 ) + 2];
+            dst[( i * 3 ) + 2] = first;
+        }
+    }
+
+    /// Interleave count shades of the three given planes in count pixels of three shades
+    /// So the pixel i of dst is { first[i], second[i], third[i] }
+    static void interleavePlanes( const Shade* const first, const Shade* const second, const Shade* const third,
+                                  Shade* const dst, const size_t count ) {
+        size_t i = 0;
+
+#ifdef IMAGE_SIMD_X86
+        if ( SIMD::hasSSSE3() ) {
+            i = SIMD::interleavePlanesSSSE3( first, second, third, dst, count );
+        }
+#endif
+
+        for ( ; i < count; ++i ) {
+            dst[( i * 3 )] = first[i];
+            dst[( i * 3 ) + 1] = second[i];
+            dst[( i * 3 ) + 2] = third[i];
+        }
+    }
+
+    /// Split count pixels of three shades in the three given planes of count shades, the inverse of interleavePlanes
+    static void deinterleavePlanes( const Shade* const src, Shade* const first, Shade* const second,
+                                    Shade* const third, const size_t count ) {
+        size_t i = 0;
+
+#ifdef IMAGE_SIMD_X86
+        if ( SIMD::hasSSSE3() ) {
+            i = SIMD::deinterleavePlanesSSSE3( src, first, second, third, count );
+        }
+#endif
+
+        for ( ; i < count; ++i ) {
+            first[i] = src[( i * 3 )];
+            second[i] = src[( i * 3 ) + 1];
+            third[i] = src[( i * 3 ) + 2];
+        }
     }
 
     static void verifyStreamContainData( std::istream& is ) {
@@ -248,6 +528,14 @@ namespace imageUtils {
             }
         }
 
+        /// Do nothing except throw, the given dimension can be coded in a file where it is at most maxDimension
+        /// \throw invalidWidth if the given width is over the given maximum
+        /// \throw invalidHeight if the given height is over the given maximum
+        static void verifyFileDimension( const intmax_t width, const intmax_t height, const intmax_t maxDimension ) {
+            verifyWidth( width, Interval<intmax_t>{ 0, maxDimension } );
+            verifyHeight( height, Interval<intmax_t>{ 0, maxDimension } );
+        }
+
         /// Do nothing except throw
         /// \throw invalidLength if the given length don't respect the given interval
         template <typename TLength>
@@ -266,6 +554,48 @@ namespace imageUtils {
             }
         }
 
+        /// Do nothing except throw, verify the given count shades with one pass
+        /// \throw invalidShade if a shade is above the given limit
+        static void verifyShades( const Shade* const shades, const size_t count, const Shade limit ) {
+            // Avec l'intensité maximale, toutes les nuances sont valides
+            if ( maxIntensity == limit ) {
+                return;
+            }
+
+            // Le maximum est calculé sans branchement, seize nuances à la fois, une seule comparaison suit
+            Shade maximum = 0;
+            size_t i = 0;
+#ifdef __SSE2__
+            i = SIMD::maxShadeSSE2( shades, count, maximum );
+#endif
+            for ( ; i < count; ++i ) {
+                maximum = std::max( maximum, shades[i] );
+            }
+
+            if ( maximum > limit ) {
+                throw invalidShade( "Bad shade" );
+            }
+        }
+
+        /// Do nothing except throw, verify the width first shades of height rows, each row holds stride shades
+        /// \throw invalidShade if a shade is above the given limit
+        static void verifyShades( const Shade* const shades, const size_t width, const size_t height, const size_t stride,
+                                  const Shade limit ) {
+            if ( maxIntensity == limit ) {
+                return;
+            }
+
+            // Sans marge, toutes les lignes sont vérifiées d'une seule passe
+            if ( stride == width ) {
+                verifyShades( shades, width * height, limit );
+                return;
+            }
+
+            for ( size_t y = 0; y < height; ++y ) {
+                verifyShades( shades + ( y * stride ), width, limit );
+            }
+        }
+
         /// Verify the given color was under or equal to the given color limit
         /// \throw invalidColor if the given color is not under or equal to the given color limit
         static void verifyColor( const Color c, const Color limit ) {
@@ -279,9 +609,9 @@ namespace imageUtils {
 
 
         /// Do nothing except throw
-        /// \throw invalidSizeArray if the given vector don't have the same size of the given maxSize
-        template <typename TPixel>
-        static void verifySizeArray( const std::vector<TPixel>& pixels, const size_t maxSize ) {
+        /// \throw invalidSizeArray if the given buffer don't have the same size of the given maxSize
+        template <typename TBuffer>
+        static void verifySizeArray( const TBuffer& pixels, const size_t maxSize ) {
             if ( pixels.size() != maxSize ) {
                 throw invalidSizeArray( "The given array does not match with the size of Image" );
             }
@@ -301,8 +631,48 @@ namespace imageUtils {
                 throw invalidCoordinateY( "The given y position is invalid" );
             }
         }
+
+        /// Do nothing except throw, verify the given row once for all the pixels of the row
+        /// \throw invalidCoordinateY if y is not in the interval [0, height[
+        static void verifyRow( const intmax_t y, const size_t height ) {
+            // Une seule comparaison : un y négatif devient un très grand entier non signé
+            if ( static_cast<uintmax_t>(y) >= height ) {
+                throw invalidCoordinateY( "The given y position is invalid" );
+            }
+        }
+
+        /// Do nothing except throw, verify a span of count pixels in a row, from start
+        /// \throw invalidCoordinateX if start.x is not in [0, width[
+        /// \throw invalidCoordinateY if start.y is not in [0, height[
+        /// \throw invalidLength if count is not in [0, width - start.x]
+        static void verifySpan( const Point start, const intmax_t count, const intmax_t width, const intmax_t height ) {
+            verifyPosition( start, Interval<intmax_t>{ 0, width }, Interval<intmax_t>{ 0, height } );
+            verifyLength( count, Interval<intmax_t>{ 0, width - start.x } );
+        }
+
+        /// Do nothing except throw, verify a rectangle at start, with the given dimension
+        /// \throw invalidCoordinateX if start.x is not in [0, width[
+        /// \throw invalidCoordinateY if start.y is not in [0, height[
+        /// \throw invalidWidth if dim.width is not in ]0, width - start.x]
+        /// \throw invalidHeight if dim.height is not in ]0, height - start.y]
+        static void verifyRectangle( const Point start, const Dimension<> dim, const intmax_t width,
+                                     const intmax_t height ) {
+            verifyPosition( start, Interval<intmax_t>{ 0, width }, Interval<intmax_t>{ 0, height } );
+            verifyWidth( dim.width, Interval<intmax_t>{ 0, width - start.x } );
+            verifyHeight( dim.height, Interval<intmax_t>{ 0, height - start.y } );
+        }
     }
 
+    /// Header of a PNM image : magic number, width, height and intensity
+    /// The intensity is a Shade for GrayImage and ColorImage, a sample of 16 bits for Image<Gray16> and Image<RGB16>
+    template <typename TSample = Shade>
+    struct PNMHeader {
+        std::string type;
+        Width width;
+        Height height;
+        TSample intensity;
+    };
+
     /// All functions contained in this namespace can read value represented by ASCII
     namespace ASCII {
         using namespace VERIFY;
@@ -339,1328 +709,3957 @@ namespace imageUtils {
             intmax_t intensity = 0;
             is >> intensity;
 
-            VERIFY::verifyIntensity( intensity, VERIFY::Interval<Shade>{0,maxIntensity} );
+            VERIFY::verifyIntensity( intensity, VERIFY::Interval<TIntensity>{0,std::numeric_limits<TIntensity>::max()} );
 
             return static_cast<TIntensity>(intensity);
         }
-    }
 
+        /// Read the header of a PNM image after its given magic number, and skip the whitespace who separates
+        /// the header of the pixels
+        /// \throws invalidWidth if the read width was outside of Interval]0, maxWidth]
+        /// \throws invalidHeight if the read height was outside of Interval]0, maxHeight]
+        /// \throws invalidIntensity if the read intensity was outside of Interval]0, maximum of TSample]
+        template <typename TSample = Shade>
+        static PNMHeader<TSample> readPNMHeader( std::istream& is, const std::string& type ) {
+            PNMHeader<TSample> header{ type, 0, 0, 0 };
 
+            skip_comments( is );
+            header.width = readWidth<Width>( is );
 
-    template <typename Type>
-    static void verifyOverEqual0UnderEqualLimitOf( const intmax_t value, const Type limit ) {
-        if ( ( 0 > value ) || ( limit < value ) ) {
-            std::ostringstream oss( "Value out [0, ", std::ios::ate );
-            oss << std::numeric_limits<intmax_t>::max() << "]";
+            skip_comments( is );
+            header.height = readHeight<Height>( is );
 
-            throw std::range_error( oss.str() );
-        }
-    }
-}
+            skip_comments( is );
+            header.intensity = readIntensity<TSample>( is );
 
-using namespace imageUtils;
+            skip_ONEwhitespace( is );
 
-// Si on passe a c++17, supprimer ce qui suit
-const Shade GrayImage::black = 0;
-const Shade& GrayImage::defaultColor = black;
-const Shade GrayImage::defaultIntensity = imageUtils::maxIntensity;
+            return header;
+        }
 
-const Color ColorImage::black = Color();
-const Color& ColorImage::defaultColor = black;
-const Shade ColorImage::defaultIntensity = imageUtils::maxIntensity;
+        /// Write the header of a PNM image : the given magic number, the author, the dimension and the intensity
+        /// The width and the height are separated by the given separator
+        static void writePNMHeader( std::ostream& os, const char* const type, const size_t width, const size_t height,
+                                    const uint32_t intensity, const char separator = ' ' ) {
+            os << type << '\n' << "# Image sauvegardée par " << ::identifier << '\n' << width << separator << height
+               << '\n' << intensity << '\n';
+        }
+    }
 
+    /// All functions contained in this namespace read values directly in a memory range [cur, end[
+    /// The given cursor cur is moved after the read data
+    namespace MEMORY {
+        using namespace VERIFY;
 
+        /// Skip all whitespaces and all comments up to a non-comment
+        static void skip_comments( const char*& cur, const char* const end ) {
+            while ( cur != end ) {
+                if ( '#' == *cur ) {
+                    // Ignore all characters up to \n
+                    cur = std::find( cur, end, '\n' );
+                }
+                else if ( 0 != std::isspace( static_cast<unsigned char>(*cur) ) ) {
+                    ++cur;
+                }
+                else {
+                    break;
+                }
+            }
+        }
 
-// Color's method
-Color::Color( const intmax_t r, const intmax_t g, const intmax_t b )
-: r_( static_cast<Shade>(r) ), g_( static_cast<Shade>(g) ), b_( static_cast<Shade>(b)) {
-    constexpr auto limit = imageUtils::maxIntensity;
+        /// Skip one whitespace of the memory range
+        static void skip_ONEwhitespace( const char*& cur, const char* const end ) {
+            if ( ( cur != end ) && ( 0 != std::isspace( static_cast<unsigned char>(*cur) ) ) ) {
+                ++cur;
+            }
+        }
 
-    VERIFY::verifyShade( r, VERIFY::Interval<Shade>{ 0, limit } );
-    VERIFY::verifyShade( g, VERIFY::Interval<Shade>{ 0, limit } );
-    VERIFY::verifyShade( b, VERIFY::Interval<Shade>{ 0, limit } );
-}
+        /// \returns The unsigned decimal value who starts at cur
+        /// \throws invalidFormat if no decimal value starts at cur, or if the value is too large
+        static intmax_t readInteger( const char*& cur, const char* const end ) {
+            if ( ( cur == end ) || ( *cur < '0' ) || ( '9' < *cur ) ) {
+                throw invalidFormat( "A decimal value was expected" );
+            }
 
-// Definitions of Color
-static Color operator+( const Color& c1, const Color& c2 ) {
-    return { static_cast<uint8_t>( std::round(imageUtils::meanIfOver255( c1.r_, c2.r_)) ),
-             static_cast<uint8_t>( std::round(imageUtils::meanIfOver255( c1.g_, c2.g_)) ),
-             static_cast<uint8_t>( std::round(imageUtils::meanIfOver255( c1.b_, c2.b_)) )
-    };
-}
-static Color operator*( const long double alpha, const Color& c ) {
-    return { static_cast<Shade>(std::round( c.r_ * alpha )), static_cast<Shade>(std::round( c.g_ * alpha )),
-             static_cast<Shade>(std::round( c.b_ * alpha )) };
-}
+            intmax_t value = 0;
+            while ( ( cur != end ) && ( '0' <= *cur ) && ( *cur <= '9' ) ) {
+                value = ( value * 10 ) + ( *cur - '0' );
 
-static bool operator==( const Color& c1, const Color& c2 ) {
-    return ( c1.r_ == c2.r_ ) && ( c1.g_ == c2.g_ ) && ( c1.b_ == c2.b_ );
-}
+                if ( std::numeric_limits<uint32_t>::max() < value ) {
+                    throw invalidFormat( "The decimal value is too large" );
+                }
+                ++cur;
+            }
 
-static bool operator!=( const Color& c1, const Color& c2 ) {
-    return !operator==( c1, c2 );
-}
-/*static Color operator*( const Color& c, const long double alpha ) {
-    return operator*(alpha, c);
-}
+            return value;
+        }
 
- static Color operator*( const Color& c, const double alpha ) {
-    return operator*(alpha, c);
-}
- static Color operator*( const double alpha, const Color& c ) {
-    return { static_cast<uint8_t>(std::round(c.r_ * alpha)),
-             static_cast<uint8_t>(std::round(c.g_ * alpha)),
-             static_cast<uint8_t>(std::round(c.b_ * alpha))
-    };
-}
-*/
+        /// Read the header of a PNM image, and skip the whitespace who separates the header of the pixels
+        /// \throws invalidWidth if the read width was outside of Interval]0, maxWidth]
+        /// \throws invalidHeight if the read height was outside of Interval]0, maxHeight]
+        /// \throws invalidIntensity if the read intensity was outside of Interval]0, maxIntensity]
+        static PNMHeader<> readPNMHeader( const char*& cur, const char* const end ) {
+            if ( ( end - cur ) < 2 ) {
+                throw invalidType( "Bad format of file" );
+            }
 
+            PNMHeader<> header{ std::string( cur, 2 ), 0, 0, 0 };
+            cur += 2;
 
+            skip_comments( cur, end );
+            const auto width = readInteger( cur, end );
+            verifyWidth( width, Interval<Width>( 0, maxWidth ) );
 
-// Definition of GrayImage's methods
+            skip_comments( cur, end );
+            const auto height = readInteger( cur, end );
+            verifyHeight( height, Interval<Height>( 0, maxHeight ) );
 
-// Public builders
-GrayImage::GrayImage( const intmax_t width, const intmax_t height )
-: GrayImage(imageUtils::Dimension<>{ width, height }, defaultIntensity ) {}
+            skip_comments( cur, end );
+            const auto intensity = readInteger( cur, end );
+            verifyIntensity( intensity, Interval<Shade>( 0, maxIntensity ) );
 
-GrayImage::GrayImage( const imageUtils::Dimension<> dim )
-: GrayImage( dim, defaultIntensity ) {}
+            skip_ONEwhitespace( cur, end );
 
-GrayImage::GrayImage( const intmax_t width, const intmax_t height, const intmax_t intensity )
-: GrayImage(imageUtils::Dimension<>{ width, height }, intensity ) {}
+            header.width = static_cast<Width>(width);
+            header.height = static_cast<Height>(height);
+            header.intensity = static_cast<Shade>(intensity);
 
-GrayImage::GrayImage( const imageUtils::Dimension<> dim, const intmax_t intensity )
-: dimension{ static_cast<Width>(dim.width), static_cast<Height>(dim.height) },
-intensity_( static_cast<Shade>(intensity) ),pixels_( dimension.width * dimension.height ) {
-    // Verify all preconditions
-    imageUtils::VERIFY::verifyWidth( dim.width, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
-    imageUtils::VERIFY::verifyHeight( dim.height, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
-    imageUtils::VERIFY::verifyIntensity( intensity, imageUtils::VERIFY::Interval<Shade>{0,imageUtils::maxIntensity} );
+            return header;
+        }
+    }
 
-    // Fill the image with the default Color
-    fill( defaultColor );
-}
+    namespace ASCII {
+        /// Read unsigned decimal values, by big chunks, without the formatted extraction of the streams
+        /// Whitespaces and comments between two values are skipped, like skip_comments does
+        /// \warning When it reads an input stream, the scanner can read characters after the last requested value
+        class SampleScanner {
+        public:
+            /// Scan the given input stream, from its current position
+            explicit SampleScanner( std::istream& is )
+                    : is_( is.rdbuf() ), buffer_( chunkSize ), cur_( buffer_.data() ), end_( buffer_.data() ) {}
+
+            /// Scan the given memory range, without copying it
+            SampleScanner( const char* const begin, const char* const end ) : cur_( begin ), end_( end ) {}
+
+            /// Read count values and store them in out
+            /// \throws invalidShade if a read value is above the given limit
+            /// \throws invalidSizeRepresentationPixel if the end was reached before reading count values
+            /// \throws invalidFormat if a character is neither a digit, nor a whitespace, nor a comment
+            template <typename TSample>
+            void read( TSample* const out, const size_t count, const TSample limit ) {
+                // Les curseurs sont copiés localement : les écritures dans out pourraient sinon les modifier
+                auto c = cur_;
+                auto e = end_;
+                auto canRefill = ( nullptr != is_ ) && !eof_;
+
+                for ( size_t i = 0; i < count; ++i ) {
+                    // Skip all whitespaces and all comments up to the next value
+                    while ( true ) {
+                        if ( canRefill && ( ( e - c ) < margin ) ) {
+                            cur_ = c;
+                            refill();
+                            c = cur_;
+                            e = end_;
+                            canRefill = !eof_;
+                        }
 
+                        if ( c == e ) {
+                            cur_ = c;
+                            throw invalidSizeRepresentationPixel(
+                                    "The end of input was encountered before the reach of all pixels" );
+                        }
 
-// Private builders
-GrayImage::GrayImage( const imageUtils::Dimension<> dim, const intmax_t intensity, std::vector<Shade>&& pixels )
-        : dimension{ static_cast<Width>(dim.width), static_cast<Height>(dim.height) },
-          intensity_( static_cast<Shade>(intensity) ), pixels_( std::move( pixels ) ) {
-    // Verify all preconditions
-    // TODO Factoriser en verifyDimension
-    imageUtils::VERIFY::verifyWidth( dim.width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
-    imageUtils::VERIFY::verifyHeight( dim.height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+                        if ( isWhitespace( *c ) ) {
+                            ++c;
+                        }
+                        else if ( '#' == *c ) {
+                            // Ignore all characters up to \n, the comment can be longer than a chunk
+                            c = std::find( c, e, '\n' );
+                        }
+                        else {
+                            break;
+                        }
+                    }
 
-    imageUtils::VERIFY::verifyIntensity( intensity,
-                                         imageUtils::VERIFY::Interval<Shade>{ 0, imageUtils::maxIntensity } );
+                    if ( !isDigit( *c ) ) {
+                        throw invalidFormat( "A decimal value was expected" );
+                    }
 
-    imageUtils::VERIFY::verifySizeArray( pixels_, dimension.width * dimension.height );
+                    // Tous les chiffres sont consommés, même les zéros de tête ou une valeur plus longue qu'un bloc
+                    // Une fois au-dessus de limit, la valeur n'est plus calculée : elle ne peut pas déborder
+                    uint64_t value = 0;
+                    while ( true ) {
+                        if ( ( c == e ) && canRefill ) {
+                            cur_ = c;
+                            refill();
+                            c = cur_;
+                            e = end_;
+                            canRefill = !eof_;
+                        }
 
-    for ( const auto pixel: pixels_ ) {
-        VERIFY::verifyShade( pixel, VERIFY::Interval<Shade>{ 0, intensity_ } );
-    }
-}
+                        if ( ( c == e ) || !isDigit( *c ) ) {
+                            break;
+                        }
 
-std::unique_ptr<GrayImage>
-GrayImage::createGrayImage( const imageUtils::Dimension<> dim, const intmax_t intensity, std::vector<Shade>&& pixels ) {
-    // Tour de magie un constructeur privé devient public dans une classe héritière
-    // Nécessaire pour le std::make_unique<GrayImage>
-    // http://www.robert-puskas.info/2018/10/lod-using-make-shared-unique-with-private-constructors.html
-    class MkGrayImage : public GrayImage {
-    public :
-        MkGrayImage( const imageUtils::Dimension<> dim, const intmax_t intensity, std::vector<Shade>&& pixels )
-                : GrayImage( dim, intensity, std::move( pixels ) ) {}
-    };
+                        if ( value <= limit ) {
+                            value = ( value * 10 ) + static_cast<uint64_t>( *c - '0' );
+                        }
+                        ++c;
+                    }
 
-    return std::make_unique<MkGrayImage>( dim, intensity, std::move( pixels ) );
-}
+                    if ( ( c != e ) && !isWhitespace( *c ) && ( '#' != *c ) ) {
+                        cur_ = c;
+                        throw invalidFormat( "A decimal value was expected" );
+                    }
 
-// Getter / Setter
-Shade& GrayImage::pixel( const intmax_t x, const intmax_t y ) {
-    const auto& imageDim = dimension;
-    VERIFY::verifyPosition( Point{x,y},
-                            VERIFY::Interval<Width>{0,imageDim.width},
-                            VERIFY::Interval<Height>{0,imageDim.height} );
+                    if ( limit < value ) {
+                        cur_ = c;
+                        throw invalidShade( "Bad shade" );
+                    }
 
-    return pixels_.at( static_cast<size_t>( ( imageDim.width * y ) + x ) );
-}
+                    out[i] = static_cast<TSample>(value);
+                }
 
-const Shade& GrayImage::pixel( const intmax_t x, const intmax_t y ) const {
-    const auto& imageDim = dimension;
-    VERIFY::verifyPosition( Point{x,y},
-                            VERIFY::Interval<Width>{0,imageDim.width},
-                            VERIFY::Interval<Height>{0,imageDim.height} );
+                cur_ = c;
+            }
 
-    return pixels_.at( static_cast<size_t>( ( imageDim.width * y ) + x ) );
-}
+            /// \returns true if the input contains only whitespaces or comments after the last read value
+            bool atEnd() {
+                skip_comments();
 
-void GrayImage::setPixel( const imageUtils::Pixel px, const intmax_t color ) {
-    const auto& imageDim = dimension;
-    imageUtils::VERIFY::verifyPosition( px, VERIFY::Interval<Width>{0,imageDim.width}, VERIFY::Interval<Height>{0,imageDim.height} );
+                return cur_ == end_;
+            }
 
-    imageUtils::VERIFY::verifyShade( color, imageUtils::VERIFY::Interval<Shade>{0,intensity_} );
+        private:
+            /// Size of the chunks read from the input stream
+            static constexpr size_t chunkSize = 64 * 1024;
 
-    pixels_.at( static_cast<size_t>( ( imageDim.width * px.y ) + px.x ) ) = static_cast<Shade>(color);
-}
+            /// A value is never cut between two chunks, while at least margin characters are available
+            static constexpr ptrdiff_t margin = 32;
 
-Shade GrayImage::getPixel( const imageUtils::Pixel px ) const {
-    const auto& imageDim = dimension;
-    imageUtils::VERIFY::verifyPosition( px, VERIFY::Interval<Width>{0,imageDim.width}, VERIFY::Interval<Height>{0,imageDim.height} );
+            std::streambuf* is_ = nullptr;
+            std::vector<char> buffer_;
+            const char* cur_;
+            const char* end_;
+            bool eof_ = false;
 
-    return pixels_.at( static_cast<size_t>( ( imageDim.width * px.y ) + px.x ) );
-}
+            /// Move the remaining characters at the beginning of the buffer and read the next chunk
+            /// Do nothing if at least margin characters remain, or if the scanner reads a memory range
+            void refill() {
+                if ( ( nullptr == is_ ) || eof_ || ( margin <= ( end_ - cur_ ) ) ) {
+                    return;
+                }
 
-// Filler
-void GrayImage::fill( const intmax_t color ) {
-    imageUtils::VERIFY::verifyShade( color, imageUtils::VERIFY::Interval<Shade>{0,intensity_} );
+                const auto remaining = static_cast<size_t>(end_ - cur_);
+                std::copy( cur_, end_, buffer_.data() );
 
-    const auto colorGrayShade = static_cast<Shade>( color );
+                const auto read = is_->sgetn( buffer_.data() + remaining,
+                                              static_cast<std::streamsize>(chunkSize - remaining) );
+                eof_ = ( 0 >= read );
 
-    std::fill( pixels_.begin(), pixels_.end(), colorGrayShade );
-}
+                cur_ = buffer_.data();
+                end_ = cur_ + remaining + ( eof_ ? 0 : read );
+            }
 
-void GrayImage::drawLine(
-        const imageUtils::Point start, const intmax_t length, const intmax_t color, const imageUtils::TYPE type ) {
-    const auto& imageDim = dimension;
+            /// Skip all whitespaces and all comments up to a non-comment
+            void skip_comments() {
+                while ( true ) {
+                    refill();
 
-    imageUtils::VERIFY::verifyPosition( start, VERIFY::Interval<Width>{0,imageDim.width}, VERIFY::Interval<Height>{0,imageDim.height} );
-    imageUtils::VERIFY::verifyShade( color, imageUtils::VERIFY::Interval<Shade>{0,intensity_} );
+                    if ( cur_ == end_ ) {
+                        return;
+                    }
 
-    switch ( type ) {
-        case imageUtils::TYPE::VERTICAL :
-            imageUtils::VERIFY::verifyLength( start.y + length, imageUtils::VERIFY::Interval<Height>{0,imageDim.height});
-            for ( intmax_t j = start.y; j < ( start.y + length ); ++j ) {
-                pixels_.at( static_cast<size_t>(( imageDim.width * j ) + start.x) ) = static_cast<Shade>(color);
+                    if ( '#' == *cur_ ) {
+                        // Ignore all characters up to \n, the comment can be longer than a chunk
+                        cur_ = std::find( cur_, end_, '\n' );
+                    }
+                    else if ( isWhitespace( *cur_ ) ) {
+                        ++cur_;
+                    }
+                    else {
+                        return;
+                    }
+                }
             }
 
-            break;
-
-        case imageUtils::TYPE::HORIZONTAL :
-            imageUtils::VERIFY::verifyLength( start.x + length, imageUtils::VERIFY::Interval<Width>{0,imageDim.width});
-            for ( intmax_t i = start.x; i < ( start.x + length ); ++i ) {
-                pixels_.at( static_cast<size_t>(( imageDim.width * start.y ) + i) ) = static_cast<Shade>(color);
+            static bool isWhitespace( const char c ) {
+                return ( ' ' == c ) || ( ( '\t' <= c ) && ( c <= '\r' ) );
             }
 
-            break;
-
-        default :
-            throw imageUtils::invalidEnumTYPE( "The given type was unknown for this function" );
+            static bool isDigit( const char c ) {
+                return ( '0' <= c ) && ( c <= '9' );
+            }
+        };
     }
-}
 
-void GrayImage::drawRectangle(
-        const imageUtils::Point start, const imageUtils::Dimension<> rectangleDim, const intmax_t color,
-        const imageUtils::FILL filled ) {
-    const auto& imageDim = dimension;
-    imageUtils::VERIFY::verifyPosition( start, VERIFY::Interval<Width>{0,imageDim.width}, VERIFY::Interval<Height>{0,imageDim.height} );
+    namespace ASCII {
+        /// Maximum number of characters on a line of a PNM image in ASCII
+        constexpr size_t pnm_limit_char = 70;
+
+        /// Write unsigned decimal values in a big buffer, written by big blocks in the output stream
+        /// The values are formatted with a table of pairs of digits, without the formatted insertion of the streams
+        /// A line never exceeds the given limit of characters, and each row of the image starts on a new line
+        /// \warning The buffer needs to be flushed with flush(), the destructor doesn't write anything
+        class SampleWriter {
+        public:
+            SampleWriter( std::ostream& os, const size_t lineLimit )
+                    : os_( os ), lineLimit_( lineLimit ), buffer_( chunkSize ), cur_( buffer_.data() ) {}
+
+            /// Write a row of count samples, the row ends with a new line
+            template <typename TSample>
+            void writeRow( const TSample* const samples, const size_t count ) {
+                for ( size_t i = 0; i < count; ++i ) {
+                    write( static_cast<uint32_t>(samples[i]) );
+                }
 
-    imageUtils::VERIFY::verifyLength( start.x + rectangleDim.width, imageUtils::VERIFY::Interval<Width>{0,imageDim.width});
-    imageUtils::VERIFY::verifyLength( start.y + rectangleDim.height, imageUtils::VERIFY::Interval<Height>{0,imageDim.height});
+                *cur_++ = '\n';
+                column_ = 0;
+            }
 
-    imageUtils::VERIFY::verifyShade( color, imageUtils::VERIFY::Interval<Shade>{0,intensity_} );
+            /// Write all the buffered characters in the output stream
+            void flush() {
+                os_.write( buffer_.data(), cur_ - buffer_.data() );
+                cur_ = buffer_.data();
+            }
 
-    switch ( filled ) {
-        case imageUtils::FILL::NO :
-            drawLine( start, rectangleDim.width, color, imageUtils::TYPE::HORIZONTAL );
-            // On soustrait deux car on trace déjà deux pixels de la ligne suivante
-            drawLine( imageUtils::Point{ start.x, start.y + 1 }, rectangleDim.height - 2, color,
-                      imageUtils::TYPE::VERTICAL );
-            drawLine( imageUtils::Point{ ( start.x - 1 ) + rectangleDim.width, start.y + 1 }, rectangleDim.height - 2,
-                      color, imageUtils::TYPE::VERTICAL );
-            drawLine( imageUtils::Point{ start.x, ( start.y - 1 ) + rectangleDim.height }, rectangleDim.width, color,
-                      imageUtils::TYPE::HORIZONTAL );
-            break;
+        private:
+            /// Size of the buffer written in one block in the output stream
+            static constexpr size_t chunkSize = 64 * 1024;
 
-        case imageUtils::FILL::YES :
-            for ( intmax_t i = start.y; i < ( start.y + rectangleDim.height ); ++i ) {
-                drawLine( imageUtils::Point{ start.x, i }, rectangleDim.width, color, imageUtils::TYPE::HORIZONTAL );
-            }
-            break;
+            /// Number of characters needed by a value, a separator, and an end of line
+            static constexpr ptrdiff_t margin = 16;
 
-        default :
-            throw imageUtils::invalidEnumTYPE( "The given type was unknown for this function" );
-    }
-}
+            /// Pairs of digits from 00 to 99
+            static const char digitPairs[201];
 
-// Writers
-// TODO Non opérationnel, impossible d'écrire en FULL ASCII
-void GrayImage::writePGM( std::ostream& os, const Format::WRITE_IN f ) const {
-    using Format = Format::WRITE_IN;
-    const auto& imageDim = dimension;
+            std::ostream& os_;
+            const size_t lineLimit_;
+            std::vector<char> buffer_;
+            char* cur_;
+            size_t column_ = 0;
 
-    // Write u=in a fonction verifyFormat( format, goodformat list )
-    if ( ( f != Format::ASCII ) && ( f != Format::BINARY ) ) {
-        throw invalidFormat( "Unknown image format" );
-    }
+            void write( uint32_t value ) {
+                if ( ( buffer_.data() + chunkSize - cur_ ) < margin ) {
+                    flush();
+                }
 
-    for ( const auto pixel: pixels_ ) {
-        VERIFY::verifyShade( pixel, VERIFY::Interval<Shade>{ 0, intensity_ } );
-    }
+                // Les chiffres sont écrits de droite à gauche, deux par deux
+                char digits[10];
+                auto first = digits + sizeof( digits );
 
-    if ( f == Format::BINARY ) {
-        // TODO Changer identifier par la variable environnement nom utilisateur
-        os << "P5\n" << "# Image sauvegardée par " << ::identifier << '\n' << imageDim.width << '\n' << imageDim.height
-           << '\n' << static_cast<uint16_t>(intensity_) << '\n';
+                while ( 100 <= value ) {
+                    const auto pair = ( value % 100 ) * 2;
+                    value /= 100;
 
+                    *--first = digitPairs[pair + 1];
+                    *--first = digitPairs[pair];
+                }
 
-        os.write( reinterpret_cast<const char*>(pixels_.data()),
-                  static_cast<std::streamsize>(imageDim.width * imageDim.height * sizeof( Shade )) );
-    }
-    else {
-        throw std::runtime_error("Le format full ascii n'est pas encore pris en charge");
-        // Full ASCII format
-        // TODO a refaire car la sortie n'est pas bonne
-        constexpr uint16_t pgm_limit_char = 70;
+                if ( 10 <= value ) {
+                    *--first = digitPairs[( value * 2 ) + 1];
+                    *--first = digitPairs[value * 2];
+                }
+                else {
+                    *--first = static_cast<char>( '0' + value );
+                }
+
+                const auto length = static_cast<size_t>(digits + sizeof( digits ) - first);
 
-        os << "P2\n" << "# Image sauvegardée par " << ::identifier << '\n' << imageDim.width << " " << imageDim.height
-           << '\n' << static_cast<uint16_t>(intensity_) << '\n';
+                // Un séparateur avant chaque valeur, sauf en début de ligne
+                if ( 0 != column_ ) {
+                    if ( lineLimit_ < ( column_ + 1 + length ) ) {
+                        *cur_++ = '\n';
+                        column_ = 0;
+                    }
+                    else {
+                        *cur_++ = ' ';
+                        ++column_;
+                    }
+                }
 
+                cur_ = std::copy( first, digits + sizeof( digits ), cur_ );
+                column_ += length;
+            }
+        };
 
-        for ( uint16_t i = 0; i < ( imageDim.width * imageDim.height ); ++i ) {
-            if ( ( 0 != i ) && imageUtils::isEndOfLine( i + 1, imageDim.width, pgm_limit_char ) ) { os << '\n'; }
+        const char SampleWriter::digitPairs[201] = "00010203040506070809"
+                                                   "10111213141516171819"
+                                                   "20212223242526272829"
+                                                   "30313233343536373839"
+                                                   "40414243444546474849"
+                                                   "50515253545556575859"
+                                                   "60616263646566676869"
+                                                   "70717273747576777879"
+                                                   "80818283848586878889"
+                                                   "90919293949596979899";
+    }
 
-            os << pixels_[i] << " ";
+    /// All functions contained in this namespace read or write the samples of the binary PNM images
+    /// A sample is coded on one byte if the intensity is under 256, else on two bytes, most significant first
+    namespace BINARY {
+        /// \returns The number of bytes of a sample, for the given intensity
+        constexpr size_t sampleSize( const uintmax_t intensity ) {
+            return ( intensity <= std::numeric_limits<uint8_t>::max() ) ? 1 : 2;
         }
-    }
 
-    os << '\n' << std::flush;
-}
+        /// Write count samples in the given output stream, each sample on the given number of bytes
+        /// \pre If size is 1, all samples are under 256
+        template <typename TSample>
+        static void writeSamples( std::ostream& os, const TSample* const samples, const size_t count, const size_t size ) {
+            // Sur un octet, les nuances d'un octet sont déjà dans l'ordre du fichier
+            if ( ( 1 == size ) && ( 1 == sizeof( TSample ) ) ) {
+                os.write( reinterpret_cast<const char*>(samples), static_cast<std::streamsize>(count) );
+                return;
+            }
 
-// Readers
-std::unique_ptr<GrayImage> GrayImage::readPGM_secured( std::istream& is ) {
-    // Lecture du nombre magique pour identifier le type d'image
-    auto p = new char[2];
-    is.read( p, 2 );
-    const std::string type( p );
+            std::vector<unsigned char> bytes( count * size );
+            auto out = bytes.data();
 
-    if ( ( type != "P5" ) && ( type != "P2" ) ) {
-        throw invalidType( "Bad format of file" );
+            for ( size_t i = 0; i < count; ++i ) {
+                if ( 2 == size ) {
+                    *out++ = static_cast<unsigned char>( samples[i] >> 8 );
+                }
+                *out++ = static_cast<unsigned char>( samples[i] & 0xFF );
+            }
+
+            os.write( reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()) );
+        }
+
+        /// Read count samples from the given input stream, each sample on the given number of bytes
+        /// \throws invalidSizeRepresentationPixel if the end of stream was reached before reading count samples
+        template <typename TSample>
+        static void readSamples( std::istream& is, TSample* const samples, const size_t count, const size_t size ) {
+            if ( ( 1 == size ) && ( 1 == sizeof( TSample ) ) ) {
+                is.read( reinterpret_cast<char*>(samples), static_cast<std::streamsize>(count) );
+            }
+            else {
+                std::vector<unsigned char> bytes( count * size );
+                is.read( reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()) );
+
+                auto in = bytes.data();
+                for ( size_t i = 0; i < count; ++i ) {
+                    uint32_t value = *in++;
+                    if ( 2 == size ) {
+                        value = ( value << 8 ) | *in++;
+                    }
+                    samples[i] = static_cast<TSample>(value);
+                }
+            }
+
+            if ( static_cast<size_t>(is.gcount()) != count * size ) {
+                throw invalidSizeRepresentationPixel( "The end of input was encountered before the reach of all pixels" );
+            }
+        }
     }
 
-    imageUtils::skip_comments( is );
-    const auto width = imageUtils::ASCII::readWidth<Width>( is );
+    /// Read-only memory mapping of a whole file
+    /// The mapping is released when the instance died
+    class MappedFile {
+    public:
+        /// Map the whole file at the given path
+        /// \exception std::runtime_error if the file can't be opened or mapped
+        explicit MappedFile( const char* const path ) {
+            const auto fd = ::open( path, O_RDONLY );
+            if ( -1 == fd ) {
+                throw std::runtime_error( "Erreur lors de l'ouverture du fichier input" );
+            }
 
-    imageUtils::skip_comments( is );
-    const auto height = imageUtils::ASCII::readHeight<Height>( is );
+            struct stat info{};
+            if ( -1 == ::fstat( fd, &info ) ) {
+                ::close( fd );
+                throw std::runtime_error( "Erreur lors de la lecture de la taille du fichier input" );
+            }
 
-    imageUtils::skip_comments( is );
-    const auto intensity = imageUtils::ASCII::readIntensity<Shade>( is );
+            size_ = static_cast<size_t>(info.st_size);
 
-    imageUtils::skip_ONEwhitespace( is );
+            // Impossible de projeter un fichier vide
+            if ( 0 < size_ ) {
+                void* const addr = ::mmap( nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+                ::close( fd );
 
-    std::vector<Shade> pixels( width * height );
+                if ( MAP_FAILED == addr ) {
+                    throw std::runtime_error( "Erreur lors de la projection en mémoire du fichier input" );
+                }
 
-    // Attraper l'exception EOF, badRead(bad bit), fail bit
-    if ( type == "P5" ) {
-        // Expliquer la lecture
-        try {
-            is.read( reinterpret_cast<char*>(pixels.data()),
-                     static_cast<std::streamsize>(width * height * sizeof( Shade )) );
-        } catch ( ... ) {
-            std::cerr << "Error occurred on stream";
+                // On lit le fichier une seule fois, du début à la fin
+                ::madvise( addr, size_, MADV_SEQUENTIAL );
+                data_ = static_cast<const char*>(addr);
+            }
+            else {
+                ::close( fd );
+            }
         }
-    }
-    else {
-        // P2 format
-        // Utiliser from_chars() en C++17
 
-        for ( size_t i = 0; i < ( width * height ); ++i ) {
-            auto tmp = 0;
-            is >> tmp;
-            pixels.at( i ) = static_cast<Shade>(tmp);
+        MappedFile( const MappedFile& ) = delete;
+        MappedFile& operator=( const MappedFile& ) = delete;
+
+        ~MappedFile() noexcept {
+            if ( nullptr != data_ ) {
+                ::munmap( const_cast<char*>(data_), size_ );
+            }
         }
-    }
 
+        const char* begin() const noexcept { return data_; }
+        const char* end() const noexcept { return data_ + size_; }
 
-    for ( const auto pixel: pixels ) {
-        VERIFY::verifyShade( pixel, VERIFY::Interval<Shade>{ 0, intensity } );
-    }
+    private:
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+    };
 
-    imageUtils::skip_ONEwhitespace( is );
 
-    //imageUtils::verifyStreamContainData( is );
 
-    return createGrayImage( imageUtils::Dimension<>{ width, height }, intensity, std::move( pixels ) );
+    template <typename Type>
+    static void verifyOverEqual0UnderEqualLimitOf( const intmax_t value, const Type limit ) {
+        if ( ( 0 > value ) || ( limit < value ) ) {
+            std::ostringstream oss( "Value out [0, ", std::ios::ate );
+            oss << std::numeric_limits<intmax_t>::max() << "]";
+
+            throw std::range_error( oss.str() );
+        }
+    }
 }
 
+using namespace imageUtils;
 
-// Scaler
-std::unique_ptr<GrayImage> GrayImage::simpleScale( const imageUtils::Dimension<> newDim ) const {
-    imageUtils::VERIFY::verifyWidth( newDim.width, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
-    imageUtils::VERIFY::verifyHeight( newDim.height, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight});
+// Si on passe a c++17, supprimer ce qui suit
+const Shade GrayImage::black = 0;
+const Shade& GrayImage::defaultColor = black;
+const Shade GrayImage::defaultIntensity = imageUtils::maxIntensity;
 
-    std::vector<Shade> pixels( static_cast<size_t>(newDim.width * newDim.height) );
+const Color ColorImage::black = Color();
+const Color& ColorImage::defaultColor = black;
+const Shade ColorImage::defaultIntensity = imageUtils::maxIntensity;
 
-    const auto& thisDim = dimension;
 
-    const auto ratioW = static_cast<long double>(thisDim.width) / newDim.width;
-    const auto ratioH = static_cast<long double>(thisDim.height) / newDim.height;
 
-    for ( Height y = 0; y < newDim.height; ++y ) {
-        for ( Width x = 0; x < newDim.width; ++x ) {
-            pixels.at( static_cast<size_t>( ( newDim.width * y ) + x) ) = getPixel(
-                    imageUtils::Pixel{ static_cast<intmax_t>(x * ratioW), static_cast<intmax_t>(y * ratioH) } );
-        }
-    }
+// Definition of BufferPool's methods
 
-    return createGrayImage( newDim, intensity_, std::move( pixels ) );
-}
+// Avant C++17, les membres statiques constexpr utilisés par référence doivent être définis
+constexpr size_t imageUtils::BufferPool::minPooledSize;
+constexpr size_t imageUtils::BufferPool::hugePageSize;
+constexpr size_t imageUtils::BufferPool::defaultCapacity;
 
-std::unique_ptr<GrayImage> GrayImage::bilinearScale( const imageUtils::Dimension<> newDim ) const {
-    // Peut simplifier la valeur de y2 et x2 car la division en bas vaut toujours 1
-    // Car y2 = std::ceil(y) ou bien y2 = y1 + 1 = std::floor(y) + 1
-    // Donc ratioY = (y -y1) / (y2 - y1) = y - y1
-    imageUtils::VERIFY::verifyWidth( newDim.width, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
-    imageUtils::VERIFY::verifyHeight( newDim.height, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
+/// State of the pool, shared by all the allocators of pixels
+struct BufferPoolState {
+    std::mutex mutex;
 
+    /// The kept buffers, by size class
+    std::map<size_t, std::vector<void*>> buffers;
 
-    std::vector<Shade> pixels( static_cast<size_t>(newDim.width * newDim.height) );
+    size_t capacity = BufferPool::defaultCapacity;
+    bool hugePages = true;
 
-    const auto& thisDim = dimension;
-    // The ratioW and ratioH was scale ratio between the new image and the old image
-    const auto ratioW = static_cast<long double>(thisDim.width) / newDim.width;
-    const auto ratioH = static_cast<long double>(thisDim.height) / newDim.height;
+    BufferPool::Statistics statistics{};
+};
 
-    // xp and yp was coordinates of pixels in the new image
-    for ( Height yp = 0; yp < newDim.height; ++yp ) {
-        // We scale the coordinate yp in the scale of the old image
-        const auto y = ( ( (ratioH * yp) - 0.5 ) < 0 ? 0 : ( (ratioH * yp) - 0.5 ) );
+static BufferPoolState& poolState() {
+    // L'état n'est jamais détruit : une image statique peut rendre ses pixels après la fin de main
+    static auto* const state = new BufferPoolState();
+    return *state;
+}
 
-        // We determine the boundary of the double y, between two nearest integers
-        // Such as : y1 <= y <= y2
-        const auto y1 = static_cast<Height>( std::floor(y) );
-        const auto y2 = static_cast<Height>( std::ceil(y) < thisDim.height ? std::ceil(y) : ( thisDim.height - 1 ) );
+/// Size of a page, the smallest alignment of a pooled buffer
+constexpr size_t pageSize = 4096;
 
-        // We determine the ratio of y between y1 and y2
-        // In the case where y1 == y2, we have a mathematical error for the division, so the result was 0.0
-        const auto ratioY = ( ( y2 != y1 ) ? ( ( y - y1 ) / ( y2 - y1 ) ) : 0.0 );
+/// \returns true if a buffer of the given size and the given alignment is pooled
+static bool isPooled( const size_t bytes, const size_t alignment ) {
+    return ( BufferPool::minPooledSize <= bytes ) && ( alignment <= pageSize );
+}
 
-        // We do the same process of the coordinate yp, for the coordinate xp
-        for ( Width xp = 0; xp < newDim.width; ++xp ) {
-            const auto x = ( ( ( ratioW * xp ) - 0.5 ) < 0 ? 0 : ( ( ratioW * xp ) - 0.5 ) );
-            const auto x1 = static_cast<Width>( std::floor(x) );
-            const auto x2 = static_cast<Width>( std::ceil(x) < thisDim.width ? std::ceil(x) : ( thisDim.width - 1 ) );
+/// \returns The size class of the given size, four classes by power of two, so at most a quarter is lost
+static size_t sizeClass( const size_t bytes ) {
+    size_t power = BufferPool::minPooledSize;
+    while ( power <= ( bytes / 2 ) ) {
+        power *= 2;
+    }
 
-            const auto ratioX = ( ( x2 != x1 ) ? ( ( x - x1 ) / ( x2 - x1 ) ) : 0.0 );
+    const size_t step = power / 4;
+    return ( ( bytes + step - 1 ) / step ) * step;
+}
 
-            // We take the gray shade of old image's pixels, who surround the new image's pixel's coordinate of x and y
-            const auto p1 = getPixel( imageUtils::Pixel{ x1, y1 } );
-            const auto p2 = getPixel( imageUtils::Pixel{ x1, y2 } );
-            const auto p3 = getPixel( imageUtils::Pixel{ x2, y1 } );
-            const auto p4 = getPixel( imageUtils::Pixel{ x2, y2 } );
+/// Free the kept buffers, from the biggest, up to keep at most the given size in the pool
+/// \pre The mutex of the state is locked
+static void evictBuffers( BufferPoolState& state, const size_t capacity ) {
+    for ( auto it = state.buffers.rbegin(); ( it != state.buffers.rend() ) && ( capacity < state.statistics.cachedBytes ); ++it ) {
+        while ( !it->second.empty() && ( capacity < state.statistics.cachedBytes ) ) {
+            free( it->second.back() );
+            it->second.pop_back();
 
-            // We apply the bilinear scale's method to the new image's pixel
-            pixels.at( static_cast<size_t>(xp + ( yp * newDim.width )) ) = static_cast<Shade>(std::round(
-                    ( ( 1 - ratioX ) * ( ( ( 1 - ratioY ) * p1 ) + ( ratioY * p2 ) ) ) +
-                    ( ratioX * ( ( ( 1 - ratioY ) * p3 ) + ( ratioY * p4 ) ) ) ));
+            --state.statistics.cachedBuffers;
+            state.statistics.cachedBytes -= it->first;
         }
     }
-
-    return createGrayImage( newDim, intensity_, std::move( pixels ) );
 }
 
+void* imageUtils::BufferPool::allocate( const size_t bytes, const size_t alignment ) {
+    void* memory = nullptr;
 
-// Definition of ColorImage's methods
+    if ( !isPooled( bytes, alignment ) ) {
+        if ( 0 != posix_memalign( &memory, alignment, std::max<size_t>( bytes, 1 ) ) ) {
+            throw std::bad_alloc();
+        }
 
-// Public builders
-ColorImage::ColorImage( const intmax_t width, const intmax_t height ) : ColorImage( width, height, defaultIntensity ) {}
+        return memory;
+    }
 
-ColorImage::ColorImage( const intmax_t width, const intmax_t height, const intmax_t intensity ) : width_(
-        static_cast<Width>(width) ), height_( static_cast<Height>(height) ), intensity_(
-        static_cast<Shade>(intensity) ), pixels_( width_ * height_ ) {
-    // Verify all preconditions
-    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
-    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
-    imageUtils::VERIFY::verifyIntensity( intensity, imageUtils::VERIFY::Interval<Shade>{0,imageUtils::maxIntensity} );
+    const auto size = sizeClass( bytes );
+    auto& state = poolState();
 
-    // Fill the image with the default Color
-    fill( defaultColor );
-}
+    bool hugePages = false;
+    {
+        std::lock_guard<std::mutex> lock( state.mutex );
+        ++state.statistics.allocations;
 
+        const auto it = state.buffers.find( size );
+        if ( ( it != state.buffers.end() ) && !it->second.empty() ) {
+            memory = it->second.back();
+            it->second.pop_back();
 
-// Private builders
-ColorImage::ColorImage(
-        const intmax_t width, const intmax_t height, const intmax_t intensity, std::vector<Color>&& pixels ) : width_(
-        static_cast<Width>(width) ), height_( static_cast<Height>(height) ), intensity_(
-        static_cast<Shade>(intensity) ), pixels_( std::move( pixels ) ) {
-    // Verify all preconditions
-    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
-    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
-    imageUtils::ASCII::verifySizeArray( pixels_, width_ * height_ );
-    imageUtils::VERIFY::verifyIntensity( intensity,
-                                         imageUtils::VERIFY::Interval<Shade>{ 0, imageUtils::maxIntensity } );
+            ++state.statistics.reuses;
+            --state.statistics.cachedBuffers;
+            state.statistics.cachedBytes -= size;
+
+            return memory;
+        }
 
-    for ( const auto color: pixels_ ) {
-        VERIFY::verifyColor( color, Color{ intensity_, intensity_, intensity_ } );
+        hugePages = state.hugePages && ( hugePageSize <= size );
     }
-}
 
-// Getter / Setter
-Color& ColorImage::pixel( const intmax_t x, const intmax_t y ) {
-    VERIFY::verifyPosition( Point{x,y},
-                            VERIFY::Interval<Width>{0,width_},
-                            VERIFY::Interval<Height>{0,height_} );
+    // Aucun tampon de cette classe dans le pool, il est alloué en dehors du verrou
+    if ( 0 != posix_memalign( &memory, hugePages ? hugePageSize : pageSize, size ) ) {
+        throw std::bad_alloc();
+    }
 
-    return pixels_.at( static_cast<size_t>( ( width_ * y ) + x ) );
+#ifdef MADV_HUGEPAGE
+    if ( hugePages && ( 0 == ::madvise( memory, size, MADV_HUGEPAGE ) ) ) {
+        std::lock_guard<std::mutex> lock( state.mutex );
+        ++state.statistics.hugePageBuffers;
+    }
+#endif
+
+    return memory;
 }
 
-const Color& ColorImage::pixel( const intmax_t x, const intmax_t y ) const {
-    VERIFY::verifyPosition( Point{x,y},
-                            VERIFY::Interval<Width>{0,width_},
-                            VERIFY::Interval<Height>{0,height_} );
+void imageUtils::BufferPool::deallocate( void* const memory, const size_t bytes, const size_t alignment ) noexcept {
+    if ( ( nullptr == memory ) || !isPooled( bytes, alignment ) ) {
+        free( memory );
+        return;
+    }
 
-    return pixels_.at( static_cast<size_t>( ( width_ * y ) + x ) );
-}
+    const auto size = sizeClass( bytes );
+    auto& state = poolState();
 
-// Filler
-void ColorImage::fill( const Color color ) {
-    std::fill( pixels_.begin(), pixels_.end(), color );
-}
+    std::lock_guard<std::mutex> lock( state.mutex );
 
-void ColorImage::horizontalLine( const intmax_t x, const intmax_t y, const intmax_t length, const Color color ) {
-    VERIFY::verifyPosition( Point{x,y},
-                            VERIFY::Interval<Width>{0,width_},
-                            VERIFY::Interval<Height>{0,height_} );
-    imageUtils::VERIFY::verifyLength( length, imageUtils::VERIFY::Interval<Width>{0,width_ - x} );
-    imageUtils::VERIFY::verifyColor( color, Color( intensity_, intensity_, intensity_ ) );
+    if ( state.capacity < ( state.statistics.cachedBytes + size ) ) {
+        ++state.statistics.discards;
+        free( memory );
+        return;
+    }
 
-    for ( intmax_t i = x; i < ( x + length ); ++i ) {
-        pixel( i, y ) = color;
+    try {
+        state.buffers[size].push_back( memory );
+    } catch ( ... ) {
+        // Sans mémoire pour le garder, le tampon est libéré
+        ++state.statistics.discards;
+        free( memory );
+        return;
     }
+
+    ++state.statistics.cachedBuffers;
+    state.statistics.cachedBytes += size;
 }
 
-void ColorImage::verticalLine( const intmax_t x, const intmax_t y, const intmax_t length, const Color color ) {
-    VERIFY::verifyPosition( Point{x,y},
-                            VERIFY::Interval<Width>{0,width_},
-                            VERIFY::Interval<Height>{0,height_} );
-    imageUtils::VERIFY::verifyLength( length, imageUtils::VERIFY::Interval<Height>{0,height_ - y} );
-    imageUtils::VERIFY::verifyColor( color, Color( intensity_, intensity_, intensity_ ) );
+void imageUtils::BufferPool::setCapacity( const size_t bytes ) {
+    auto& state = poolState();
+    std::lock_guard<std::mutex> lock( state.mutex );
 
-    for ( intmax_t j = y; j < ( y + length ); ++j ) {
-        pixel( x, j ) = color;
-    }
+    state.capacity = bytes;
+    evictBuffers( state, bytes );
 }
 
-void ColorImage::rectangle(
-        const intmax_t x, const intmax_t y, const intmax_t width, const intmax_t height, const Color color ) {
-    VERIFY::verifyPosition( Point{x,y},
-                            VERIFY::Interval<Width>{0,width_},
-                            VERIFY::Interval<Height>{0,height_} );
-    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{0,width_ - x} );
-    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{0,height_ - y} );
-    imageUtils::VERIFY::verifyColor( color, Color( intensity_, intensity_, intensity_ ) );
-
-    horizontalLine( x, y, width, color );
-    horizontalLine( x, ( y - 1 ) + height, width, color );
+void imageUtils::BufferPool::setHugePages( const bool enabled ) {
+    auto& state = poolState();
+    std::lock_guard<std::mutex> lock( state.mutex );
 
-    verticalLine( x, y + 1, height - 2, color );
-    verticalLine( ( x - 1 ) + width, y + 1, height - 2, color );
+    state.hugePages = enabled;
 }
 
-void ColorImage::fillRectangle(
-        const intmax_t x, const intmax_t y, const intmax_t width, const intmax_t height, const Color color ) {
-    VERIFY::verifyPosition( Point{x,y},
-                            VERIFY::Interval<Width>{0,width_},
-                            VERIFY::Interval<Height>{0,height_} );
-    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{0,width_ - x} );
-    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{0,height_ - y} );
-    imageUtils::VERIFY::verifyColor( color, Color( intensity_, intensity_, intensity_ ) );
+void imageUtils::BufferPool::trim() {
+    auto& state = poolState();
+    std::lock_guard<std::mutex> lock( state.mutex );
 
-    for ( intmax_t i = y; i < ( y + height ); ++i ) {
-        horizontalLine( x, i, width, color );
-    }
+    evictBuffers( state, 0 );
 }
 
-// Writers
-void ColorImage::writePPM( std::ostream& os, const Format::WRITE_IN f ) const {
-    using Format = Format::WRITE_IN;
-
-    if ( ( f != Format::ASCII ) && ( f != Format::BINARY ) ) {
-        throw invalidFormat( "Unknown image format" );
-    }
+imageUtils::BufferPool::Statistics imageUtils::BufferPool::statistics() {
+    auto& state = poolState();
+    std::lock_guard<std::mutex> lock( state.mutex );
 
-    // Pas utile de vérifier le max, lors de la création de couleur on vérifie déjà
-//    for ( const auto color : pixels_ ) {
-//        VERIFY::verifyColor( color, Color{intensity_, intensity_, intensity_});
-//    }
+    return state.statistics;
+}
 
-    if ( f == Format::BINARY ) {
-        os << "P6\n" << "# Image sauvegardée par " << ::identifier << '\n' << width_ << " " << height_ << '\n'
-           << static_cast<uint16_t>(intensity_) << '\n';
 
-        os.write( reinterpret_cast<const char*>(pixels_.data()),
-                  static_cast<std::streamsize>(width_ * height_ * sizeof( Color )) );
-    }
-    else {
-        // Full ASCII format
-        // TODO Corriger l'écriture en FULL ASCII
-        throw std::runtime_error("La fonction ne permet pas d'écrire en full ascii");
-        constexpr uint16_t pgm_limit_char = 70;
+// Color's method
+static_assert( sizeof( Color ) == 3, "Color needs to be three packed shades, in the order red, green, blue" );
 
-        os << "P3\n" << "# Image sauvegardée par " << ::identifier << '\n'
-           << width_ << " " << height_ << '\n'
-           << static_cast<uint16_t>(intensity_) << '\n';
+Color::Color( const intmax_t r, const intmax_t g, const intmax_t b )
+: r_( static_cast<Shade>(r) ), g_( static_cast<Shade>(g) ), b_( static_cast<Shade>(b)) {
+    constexpr auto limit = imageUtils::maxIntensity;
 
-        for ( uint16_t i = 0; i < ( width_ * height_ ); ++i ) {
-            if ( ( 0 != i ) && imageUtils::isEndOfLine( i+1, width_, pgm_limit_char ) ) { os << '\n'; }
+    VERIFY::verifyShade( r, VERIFY::Interval<Shade>{ 0, limit } );
+    VERIFY::verifyShade( g, VERIFY::Interval<Shade>{ 0, limit } );
+    VERIFY::verifyShade( b, VERIFY::Interval<Shade>{ 0, limit } );
+}
 
-            os << static_cast<uint16_t>(pixels_[i].r_) << " " << static_cast<uint16_t>(pixels_[i].g_) << " "
-               << static_cast<uint16_t>(pixels_[i].b_) << " ";
-        }
-    }
+// Definitions of the operations on the shades of a color, applied channel by channel on the planes
+/// \returns The sum of the two shades, or their mean if the sum is over 255
+static Shade addShades( const Shade s1, const Shade s2 ) {
+    return static_cast<Shade>( std::round( imageUtils::meanIfOver255( s1, s2 ) ) );
+}
 
-    os << '\n';
+/// \returns The rounded product of the shade by alpha
+static Shade scaleShade( const long double alpha, const Shade s ) {
+    return static_cast<Shade>( std::round( s * alpha ) );
 }
 
-void ColorImage::writeTGA( std::ostream& os, const Format::WRITE_IN f ) const {
-    // oneByte 1 = 0 because no identification information for the image
-    os.put( 0 );
+/*static Color operator*( const Color& c, const long double alpha ) {
+    return operator*(alpha, c);
+}
+
+ static Color operator*( const Color& c, const double alpha ) {
+    return operator*(alpha, c);
+}
+ static Color operator*( const double alpha, const Color& c ) {
+    return { static_cast<uint8_t>(std::round(c.r_ * alpha)),
+             static_cast<uint8_t>(std::round(c.g_ * alpha)),
+             static_cast<uint8_t>(std::round(c.b_ * alpha))
+    };
+}
+*/
+
+
+
+// Definition of ImageView's methods
+template <typename TPixel>
+imageUtils::ImageView<TPixel>::ImageView(
+        TPixel* const data, const intmax_t width, const intmax_t height, const size_t stride, const Sample intensity )
+        : data_( data ), width_( static_cast<Width>(width) ), height_( static_cast<Height>(height) ), stride_( stride ),
+          intensity_( intensity ) {
+    VERIFY::verifyWidth( width, VERIFY::Interval<Width>{ 0, maxWidth } );
+    VERIFY::verifyHeight( height, VERIFY::Interval<Height>{ 0, maxHeight } );
+
+    if ( stride_ < width_ ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
+    }
+}
+
+template <typename TPixel>
+TPixel& imageUtils::ImageView<TPixel>::pixel( const intmax_t x, const intmax_t y ) const {
+    VERIFY::verifyPosition( Point{ x, y }, VERIFY::Interval<Width>{ 0, width_ }, VERIFY::Interval<Height>{ 0, height_ } );
+
+    return row( static_cast<size_t>(y) )[x];
+}
+
+template <typename TPixel>
+imageUtils::ImageView<TPixel>
+imageUtils::ImageView<TPixel>::region( const Point start, const Dimension<> dim ) const {
+    VERIFY::verifyPosition( start, VERIFY::Interval<Width>{ 0, width_ }, VERIFY::Interval<Height>{ 0, height_ } );
+    VERIFY::verifyWidth( dim.width, VERIFY::Interval<Width>{ 0, width_ - start.x } );
+    VERIFY::verifyHeight( dim.height, VERIFY::Interval<Height>{ 0, height_ - start.y } );
+
+    // La vue garde le pas de cette vue, aucun pixel n'est copié
+    return ImageView( row( static_cast<size_t>(start.y) ) + start.x, dim.width, dim.height, stride_, intensity_ );
+}
+
+// Seules les vues sur les nuances et les couleurs des images, sur 8 ou 16 bits, existent
+template class imageUtils::ImageView<Shade>;
+template class imageUtils::ImageView<const Shade>;
+template class imageUtils::ImageView<Color>;
+template class imageUtils::ImageView<const Color>;
+template class imageUtils::ImageView<uint16_t>;
+template class imageUtils::ImageView<const uint16_t>;
+template class imageUtils::ImageView<Color16>;
+template class imageUtils::ImageView<const Color16>;
+
+
+// Managers of the JPEG library, shared by the gray and color images
+
+/// Do nothing except throw, the library stops the program on a dimension over JPEG_MAX_DIMENSION
+/// \exception invalidWidth if the given width is over JPEG_MAX_DIMENSION
+/// \exception invalidHeight if the given height is over JPEG_MAX_DIMENSION
+static void verifyJPEGDimension( const intmax_t width, const intmax_t height ) {
+    imageUtils::VERIFY::verifyFileDimension( width, height, JPEG_MAX_DIMENSION );
+}
+
+/// Destination of the JPEG library who writes in an output stream, by big blocks
+/// \warning pub needs to be the first member, the library only knows it
+struct JPEGStreamDestination {
+    jpeg_destination_mgr pub;
+    std::ostream* os;
+    std::vector<JOCTET> buffer;
+
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    explicit JPEGStreamDestination( std::ostream& output ) : pub(), os( &output ), buffer( chunkSize ) {
+        pub.init_destination = []( j_compress_ptr cinfo ) {
+            auto dest = reinterpret_cast<JPEGStreamDestination*>(cinfo->dest);
+            dest->pub.next_output_byte = dest->buffer.data();
+            dest->pub.free_in_buffer = dest->buffer.size();
+        };
+
+        // Le tampon est plein : il est écrit en entier
+        pub.empty_output_buffer = []( j_compress_ptr cinfo ) -> boolean {
+            auto dest = reinterpret_cast<JPEGStreamDestination*>(cinfo->dest);
+            dest->os->write( reinterpret_cast<const char*>(dest->buffer.data()),
+                             static_cast<std::streamsize>(dest->buffer.size()) );
+
+            dest->pub.next_output_byte = dest->buffer.data();
+            dest->pub.free_in_buffer = dest->buffer.size();
+            return TRUE;
+        };
+
+        pub.term_destination = []( j_compress_ptr cinfo ) {
+            auto dest = reinterpret_cast<JPEGStreamDestination*>(cinfo->dest);
+            dest->os->write( reinterpret_cast<const char*>(dest->buffer.data()),
+                             static_cast<std::streamsize>(dest->buffer.size() - dest->pub.free_in_buffer) );
+            dest->os->flush();
+        };
+    }
+};
+
+/// Destination of the JPEG library who writes in a buffer, its size is doubled when it is full
+/// \warning pub needs to be the first member, the library only knows it
+struct JPEGVectorDestination {
+    jpeg_destination_mgr pub;
+    std::vector<uint8_t>* output;
+
+    static constexpr size_t initialSize = 64 * 1024;
+
+    explicit JPEGVectorDestination( std::vector<uint8_t>& buffer ) : pub(), output( &buffer ) {
+        pub.init_destination = []( j_compress_ptr cinfo ) {
+            auto dest = reinterpret_cast<JPEGVectorDestination*>(cinfo->dest);
+            dest->output->resize( std::max( size_t( initialSize ), dest->output->capacity() ) );
+
+            dest->pub.next_output_byte = dest->output->data();
+            dest->pub.free_in_buffer = dest->output->size();
+        };
+
+        pub.empty_output_buffer = []( j_compress_ptr cinfo ) -> boolean {
+            auto dest = reinterpret_cast<JPEGVectorDestination*>(cinfo->dest);
+            const auto used = dest->output->size();
+            dest->output->resize( used * 2 );
+
+            dest->pub.next_output_byte = dest->output->data() + used;
+            dest->pub.free_in_buffer = dest->output->size() - used;
+            return TRUE;
+        };
+
+        // Le tampon garde seulement l'image compressée
+        pub.term_destination = []( j_compress_ptr cinfo ) {
+            auto dest = reinterpret_cast<JPEGVectorDestination*>(cinfo->dest);
+            dest->output->resize( dest->output->size() - dest->pub.free_in_buffer );
+        };
+    }
+};
+
+/// Source of the JPEG library who reads an input stream by big blocks, or a buffer without copy
+/// \warning pub needs to be the first member, the library only knows it
+struct JPEGSource {
+    jpeg_source_mgr pub;
+    std::streambuf* is = nullptr;
+    std::vector<JOCTET> buffer;
+
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    /// Read the given input stream
+    explicit JPEGSource( std::istream& input ) : JPEGSource( nullptr, 0 ) {
+        is = input.rdbuf();
+        buffer.resize( chunkSize );
+    }
+
+    /// Read the given buffer, without copy
+    JPEGSource( const uint8_t* const data, const size_t size ) : pub() {
+        pub.next_input_byte = data;
+        pub.bytes_in_buffer = size;
+
+        pub.init_source = []( j_decompress_ptr ) {};
+        pub.resync_to_restart = jpeg_resync_to_restart;
+        pub.term_source = []( j_decompress_ptr ) {};
+
+        pub.fill_input_buffer = []( j_decompress_ptr cinfo ) -> boolean {
+            auto src = reinterpret_cast<JPEGSource*>(cinfo->src);
+
+            std::streamsize read = 0;
+            if ( nullptr != src->is ) {
+                read = src->is->sgetn( reinterpret_cast<char*>(src->buffer.data()),
+                                       static_cast<std::streamsize>(src->buffer.size()) );
+            }
+
+            if ( 0 < read ) {
+                src->pub.next_input_byte = src->buffer.data();
+                src->pub.bytes_in_buffer = static_cast<size_t>(read);
+            }
+            else {
+                // Fin prématurée des données : on insère un marqueur de fin d'image, comme jpeg_stdio_src
+                static const JOCTET endOfImage[] = { 0xFF, JPEG_EOI };
+
+                WARNMS( cinfo, JWRN_JPEG_EOF );
+                src->pub.next_input_byte = endOfImage;
+                src->pub.bytes_in_buffer = sizeof( endOfImage );
+            }
+
+            return TRUE;
+        };
+
+        pub.skip_input_data = []( j_decompress_ptr cinfo, long count ) {
+            auto src = reinterpret_cast<JPEGSource*>(cinfo->src);
+
+            while ( static_cast<long>(src->pub.bytes_in_buffer) < count ) {
+                count -= static_cast<long>(src->pub.bytes_in_buffer);
+                src->pub.fill_input_buffer( cinfo );
+            }
+
+            if ( 0 < count ) {
+                src->pub.next_input_byte += count;
+                src->pub.bytes_in_buffer -= static_cast<size_t>(count);
+            }
+        };
+    }
+};
+
+/// Error manager of the JPEG library who throws an exception, instead of stopping the program
+/// \warning pub needs to be the first member, the library only knows it
+struct JPEGErrorManager {
+    jpeg_error_mgr pub;
+
+    JPEGErrorManager() : pub() {
+        jpeg_std_error( &pub );
+
+        // Par défaut la bibliothèque appelle exit() : l'erreur est levée en exception
+        pub.error_exit = []( j_common_ptr cinfo ) {
+            char message[JMSG_LENGTH_MAX];
+            ( *cinfo->err->format_message )( cinfo, message );
+
+            throw invalidJPEG( message );
+        };
+    }
+};
+
+/// Compression object of the JPEG library, destroyed even if an exception is thrown
+struct JPEGCompression {
+    jpeg_compress_struct cinfo;
+    JPEGErrorManager errors;
+
+    JPEGCompression() : cinfo(), errors() {
+        cinfo.err = &errors.pub;
+        jpeg_create_compress( &cinfo );
+    }
+
+    JPEGCompression( const JPEGCompression& ) = delete;
+    JPEGCompression& operator=( const JPEGCompression& ) = delete;
+
+    ~JPEGCompression() noexcept { jpeg_destroy_compress( &cinfo ); }
+};
+
+/// Decompression object of the JPEG library, destroyed even if an exception is thrown
+struct JPEGDecompression {
+    jpeg_decompress_struct cinfo;
+    JPEGErrorManager errors;
+
+    JPEGDecompression() : cinfo(), errors() {
+        cinfo.err = &errors.pub;
+        jpeg_create_decompress( &cinfo );
+    }
+
+    JPEGDecompression( const JPEGDecompression& ) = delete;
+    JPEGDecompression& operator=( const JPEGDecompression& ) = delete;
+
+    ~JPEGDecompression() noexcept { jpeg_destroy_decompress( &cinfo ); }
+};
+
+/// File of the C library given to the JPEG library, closed even if an exception is thrown
+struct StdioFile {
+    FILE* file;
+
+    /// \exception std::runtime_error with the given message if the file can not be opened
+    StdioFile( const char* const path, const char* const mode, const char* const message ) : file( fopen( path, mode ) ) {
+        if ( nullptr == file ) {
+            throw std::runtime_error( message );
+        }
+    }
+
+    StdioFile( const StdioFile& ) = delete;
+    StdioFile& operator=( const StdioFile& ) = delete;
+
+    ~StdioFile() noexcept { fclose( file ); }
+};
+
+/// Decompress the next lines of the started decompressor in the given buffer, several lines per call of the library
+/// \pre The buffer needs to hold output_width * output_components * lines samples
+/// \pre lines <= output_height - output_scanline
+/// \exception invalidJPEG if the library reports an error, or stops to give lines before the last one
+static void readScanlines( jpeg_decompress_struct& cinfo, JSAMPLE* const output, const JDIMENSION lines ) {
+    constexpr JDIMENSION linesPerCall = 16;
+    const size_t stride = static_cast<size_t>(cinfo.output_width) * cinfo.output_components;
+    const auto first = cinfo.output_scanline;
+    const auto last = first + lines;
+
+    JSAMPROW rows[linesPerCall];
+    while ( cinfo.output_scanline < last ) {
+        const auto count = std::min( linesPerCall, last - cinfo.output_scanline );
+        for ( JDIMENSION i = 0; i < count; ++i ) {
+            rows[i] = output + ( ( cinfo.output_scanline - first + i ) * stride );
+        }
+
+        // Sans ligne décompressée, la boucle ne finirait jamais
+        if ( 0 == jpeg_read_scanlines( &cinfo, rows, count ) ) {
+            throw invalidJPEG( "The JPEG library stopped before the last line" );
+        }
+    }
+}
+
+
+// Definition of GrayImage's methods
+
+// Public builders
+GrayImage::GrayImage( const intmax_t width, const intmax_t height )
+: GrayImage(imageUtils::Dimension<>{ width, height }, defaultIntensity ) {}
+
+GrayImage::GrayImage( const imageUtils::Dimension<> dim )
+: GrayImage( dim, defaultIntensity ) {}
+
+GrayImage::GrayImage( const intmax_t width, const intmax_t height, const intmax_t intensity )
+: GrayImage(imageUtils::Dimension<>{ width, height }, intensity ) {}
+
+GrayImage::GrayImage( const imageUtils::Dimension<> dim, const intmax_t intensity )
+: GrayImage( dim, intensity, static_cast<size_t>(std::max<intmax_t>( dim.width, 0 )) ) {}
+
+GrayImage::GrayImage( const imageUtils::Dimension<> dim, const intmax_t intensity, const size_t stride )
+: dimension{ static_cast<Width>(dim.width), static_cast<Height>(dim.height) },
+intensity_( static_cast<Shade>(intensity) ), stride_( stride ) {
+    // Verify all preconditions
+    imageUtils::VERIFY::verifyWidth( dim.width, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
+    imageUtils::VERIFY::verifyHeight( dim.height, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
+    imageUtils::VERIFY::verifyIntensity( intensity, imageUtils::VERIFY::Interval<Shade>{0,imageUtils::maxIntensity} );
+
+    if ( stride_ < dimension.width ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
+    }
+
+    // fill écrit chaque nuance une seule fois, la marge des lignes reste non initialisée
+    pixels_ = imageUtils::uninitializedBuffer<Shade>( stride_ * dimension.height );
+
+    // Fill the image with the default Color
+    fill( defaultColor );
+}
+
+
+// Private builders
+GrayImage::GrayImage( const imageUtils::Dimension<> dim, const intmax_t intensity, Pixels&& pixels )
+        : GrayImage( dim, intensity, static_cast<size_t>(std::max<intmax_t>( dim.width, 0 )), std::move( pixels ) ) {}
+
+GrayImage::GrayImage(
+        const imageUtils::Dimension<> dim, const intmax_t intensity, const size_t stride, Pixels&& pixels,
+        const imageUtils::VERIFIED verified )
+        : dimension{ static_cast<Width>(dim.width), static_cast<Height>(dim.height) },
+          intensity_( static_cast<Shade>(intensity) ), stride_( stride ), pixels_( std::move( pixels ) ) {
+    // Verify all preconditions
+    // TODO Factoriser en verifyDimension
+    imageUtils::VERIFY::verifyWidth( dim.width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( dim.height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+
+    imageUtils::VERIFY::verifyIntensity( intensity,
+                                         imageUtils::VERIFY::Interval<Shade>{ 0, imageUtils::maxIntensity } );
+
+    if ( stride_ < dimension.width ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
+    }
+
+    imageUtils::VERIFY::verifySizeArray( pixels_, stride_ * dimension.height );
+
+    // Les nuances produites par la bibliothèque sont déjà valides
+    // La marge des lignes n'est pas initialisée, elle n'est pas vérifiée
+    if ( imageUtils::VERIFIED::NO == verified ) {
+        VERIFY::verifyShades( pixels_.data(), dimension.width, dimension.height, stride_, intensity_ );
+    }
+}
+
+std::unique_ptr<GrayImage>
+GrayImage::createGrayImage( const imageUtils::Dimension<> dim, const intmax_t intensity, Pixels&& pixels ) {
+    return createGrayImage( dim, intensity, static_cast<size_t>(std::max<intmax_t>( dim.width, 0 )), std::move( pixels ) );
+}
+
+std::unique_ptr<GrayImage> GrayImage::createGrayImage(
+        const imageUtils::Dimension<> dim, const intmax_t intensity, const size_t stride, Pixels&& pixels,
+        const imageUtils::VERIFIED verified ) {
+    // Tour de magie un constructeur privé devient public dans une classe héritière
+    // Nécessaire pour le std::make_unique<GrayImage>
+    // http://www.robert-puskas.info/2018/10/lod-using-make-shared-unique-with-private-constructors.html
+    class MkGrayImage : public GrayImage {
+    public :
+        MkGrayImage(
+                const imageUtils::Dimension<> dim, const intmax_t intensity, const size_t stride, Pixels&& pixels,
+                const imageUtils::VERIFIED verified )
+                : GrayImage( dim, intensity, stride, std::move( pixels ), verified ) {}
+    };
+
+    return std::make_unique<MkGrayImage>( dim, intensity, stride, std::move( pixels ), verified );
+}
+
+// Reshape
+void GrayImage::reshape( const imageUtils::Dimension<> dim ) {
+    reshape( dim, intensity_ );
+}
+
+void GrayImage::reshape( const imageUtils::Dimension<> dim, const intmax_t intensity ) {
+    // Verify all preconditions
+    imageUtils::VERIFY::verifyWidth( dim.width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( dim.height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+    imageUtils::VERIFY::verifyIntensity( intensity,
+                                         imageUtils::VERIFY::Interval<Shade>{ 0, imageUtils::maxIntensity } );
+
+    // Une image aux lignes alignées le reste
+    const size_t newStride = ( stride_ == dimension.width ) ? static_cast<size_t>(dim.width)
+                                                             : imageUtils::alignedStride<Shade>( dim.width );
+    const size_t size = newStride * static_cast<size_t>(dim.height);
+
+    // Les anciennes nuances ne sont pas conservées : un nouveau tampon évite à resize de les recopier
+    imageUtils::reshapeBuffer( pixels_, size );
+
+    dimension = imageUtils::Dimension<Width, Height>{ static_cast<Width>(dim.width), static_cast<Height>(dim.height) };
+    intensity_ = static_cast<Shade>(intensity);
+    stride_ = newStride;
+}
+
+// Getter / Setter
+Shade& GrayImage::pixel( const intmax_t x, const intmax_t y ) {
+    const auto& imageDim = dimension;
+    VERIFY::verifyPosition( Point{x,y},
+                            VERIFY::Interval<Width>{0,imageDim.width},
+                            VERIFY::Interval<Height>{0,imageDim.height} );
+
+    // La position est vérifiée, l'indice ne l'est pas une seconde fois
+    return pixels_[( stride_ * static_cast<size_t>(y) ) + static_cast<size_t>(x)];
+}
+
+const Shade& GrayImage::pixel( const intmax_t x, const intmax_t y ) const {
+    const auto& imageDim = dimension;
+    VERIFY::verifyPosition( Point{x,y},
+                            VERIFY::Interval<Width>{0,imageDim.width},
+                            VERIFY::Interval<Height>{0,imageDim.height} );
+
+    // La position est vérifiée, l'indice ne l'est pas une seconde fois
+    return pixels_[( stride_ * static_cast<size_t>(y) ) + static_cast<size_t>(x)];
+}
+
+void GrayImage::setPixel( const imageUtils::Pixel px, const intmax_t color ) {
+    const auto& imageDim = dimension;
+    imageUtils::VERIFY::verifyPosition( px, VERIFY::Interval<Width>{0,imageDim.width}, VERIFY::Interval<Height>{0,imageDim.height} );
+
+    imageUtils::VERIFY::verifyShade( color, imageUtils::VERIFY::Interval<Shade>{0,intensity_} );
+
+    pixels_[( stride_ * static_cast<size_t>(px.y) ) + static_cast<size_t>(px.x)] = static_cast<Shade>(color);
+}
+
+Shade GrayImage::getPixel( const imageUtils::Pixel px ) const {
+    const auto& imageDim = dimension;
+    imageUtils::VERIFY::verifyPosition( px, VERIFY::Interval<Width>{0,imageDim.width}, VERIFY::Interval<Height>{0,imageDim.height} );
+
+    return pixels_[( stride_ * static_cast<size_t>(px.y) ) + static_cast<size_t>(px.x)];
+}
+
+Shade* GrayImage::row( const intmax_t y ) {
+    VERIFY::verifyRow( y, dimension.height );
+
+    return pixels_.data() + ( stride_ * static_cast<size_t>(y) );
+}
+
+const Shade* GrayImage::row( const intmax_t y ) const {
+    VERIFY::verifyRow( y, dimension.height );
+
+    return pixels_.data() + ( stride_ * static_cast<size_t>(y) );
+}
+
+void GrayImage::setRow( const imageUtils::Point start, const Shade* const source, const intmax_t count ) {
+    setRow( view(), start, source, count );
+}
+
+void GrayImage::setRow( const View view, const imageUtils::Point start, const Shade* const source, const intmax_t count ) {
+    VERIFY::verifySpan( start, count, view.width(), view.height() );
+    VERIFY::verifyShades( source, static_cast<size_t>(count), view.intensity() );
+
+    std::memcpy( view.row( static_cast<size_t>(start.y) ) + start.x, source, static_cast<size_t>(count) * sizeof( Shade ) );
+}
+
+void GrayImage::getRow( const imageUtils::Point start, Shade* const destination, const intmax_t count ) const {
+    getRow( view(), start, destination, count );
+}
+
+void GrayImage::getRow( const ConstView view, const imageUtils::Point start, Shade* const destination, const intmax_t count ) {
+    VERIFY::verifySpan( start, count, view.width(), view.height() );
+
+    std::memcpy( destination, view.row( static_cast<size_t>(start.y) ) + start.x, static_cast<size_t>(count) * sizeof( Shade ) );
+}
+
+void GrayImage::copyRect( const Shade* const source, const size_t stride, const imageUtils::Point start,
+                          const imageUtils::Dimension<> dim ) {
+    copyRect( view(), source, stride, start, dim );
+}
+
+void GrayImage::copyRect( const View view, const Shade* const source, const size_t stride, const imageUtils::Point start,
+                          const imageUtils::Dimension<> dim ) {
+    VERIFY::verifyRectangle( start, dim, view.width(), view.height() );
+
+    const auto width = static_cast<size_t>(dim.width);
+    const auto height = static_cast<size_t>(dim.height);
+    if ( stride < width ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
+    }
+
+    // Toutes les lignes sont vérifiées avant la copie, l'image n'est pas modifiée en cas d'erreur
+    for ( size_t y = 0; y < height; ++y ) {
+        VERIFY::verifyShades( source + ( y * stride ), width, view.intensity() );
+    }
+
+    for ( size_t y = 0; y < height; ++y ) {
+        std::memcpy( view.row( static_cast<size_t>(start.y) + y ) + start.x, source + ( y * stride ), width * sizeof( Shade ) );
+    }
+}
+
+// Filler
+void GrayImage::fill( const intmax_t color ) {
+    fill( view(), color );
+}
+
+void GrayImage::fill( const View view, const intmax_t color ) {
+    imageUtils::VERIFY::verifyShade( color, imageUtils::VERIFY::Interval<Shade>{0,view.intensity()} );
+
+    const auto colorGrayShade = static_cast<Shade>( color );
+
+    // Sans marge, toutes les nuances sont contiguës
+    if ( view.stride() == view.width() ) {
+        std::fill( view.row( 0 ), view.row( 0 ) + ( view.stride() * view.height() ), colorGrayShade );
+        return;
+    }
+
+    view.forEachRow( [colorGrayShade]( Shade* const first, Shade* const last ) {
+        std::fill( first, last, colorGrayShade );
+    } );
+}
+
+void GrayImage::drawLine(
+        const imageUtils::Point start, const intmax_t length, const intmax_t color, const imageUtils::TYPE type ) {
+    drawLine( view(), start, length, color, type );
+}
+
+void GrayImage::drawLine( const View view, const imageUtils::Point start, const intmax_t length, const intmax_t color,
+                          const imageUtils::TYPE type ) {
+    imageUtils::VERIFY::verifyPosition( start, VERIFY::Interval<Width>{0,view.width()}, VERIFY::Interval<Height>{0,view.height()} );
+    imageUtils::VERIFY::verifyShade( color, imageUtils::VERIFY::Interval<Shade>{0,view.intensity()} );
+
+    switch ( type ) {
+        case imageUtils::TYPE::VERTICAL :
+            imageUtils::VERIFY::verifyLength( start.y + length, imageUtils::VERIFY::Interval<Height>{0,view.height()});
+            for ( intmax_t j = start.y; j < ( start.y + length ); ++j ) {
+                view.row( static_cast<size_t>(j) )[start.x] = static_cast<Shade>(color);
+            }
+
+            break;
+
+        case imageUtils::TYPE::HORIZONTAL :
+            imageUtils::VERIFY::verifyLength( start.x + length, imageUtils::VERIFY::Interval<Width>{0,view.width()});
+            // Les nuances d'une ligne horizontale sont contiguës
+            std::fill_n( view.row( static_cast<size_t>(start.y) ) + start.x, length, static_cast<Shade>(color) );
+
+            break;
+
+        default :
+            throw imageUtils::invalidEnumTYPE( "The given type was unknown for this function" );
+    }
+}
+
+void GrayImage::drawRectangle(
+        const imageUtils::Point start, const imageUtils::Dimension<> rectangleDim, const intmax_t color,
+        const imageUtils::FILL filled ) {
+    drawRectangle( view(), start, rectangleDim, color, filled );
+}
+
+void GrayImage::drawRectangle(
+        const View view, const imageUtils::Point start, const imageUtils::Dimension<> rectangleDim,
+        const intmax_t color, const imageUtils::FILL filled ) {
+    imageUtils::VERIFY::verifyPosition( start, VERIFY::Interval<Width>{0,view.width()}, VERIFY::Interval<Height>{0,view.height()} );
+
+    imageUtils::VERIFY::verifyLength( start.x + rectangleDim.width, imageUtils::VERIFY::Interval<Width>{0,view.width()});
+    imageUtils::VERIFY::verifyLength( start.y + rectangleDim.height, imageUtils::VERIFY::Interval<Height>{0,view.height()});
+
+    imageUtils::VERIFY::verifyShade( color, imageUtils::VERIFY::Interval<Shade>{0,view.intensity()} );
+
+    switch ( filled ) {
+        case imageUtils::FILL::NO :
+            drawLine( view, start, rectangleDim.width, color, imageUtils::TYPE::HORIZONTAL );
+            // On soustrait deux car on trace déjà deux pixels de la ligne suivante
+            drawLine( view, imageUtils::Point{ start.x, start.y + 1 }, rectangleDim.height - 2, color,
+                      imageUtils::TYPE::VERTICAL );
+            drawLine( view, imageUtils::Point{ ( start.x - 1 ) + rectangleDim.width, start.y + 1 },
+                      rectangleDim.height - 2, color, imageUtils::TYPE::VERTICAL );
+            drawLine( view, imageUtils::Point{ start.x, ( start.y - 1 ) + rectangleDim.height }, rectangleDim.width,
+                      color, imageUtils::TYPE::HORIZONTAL );
+            break;
+
+        case imageUtils::FILL::YES :
+            // Le rectangle est vérifié une seule fois, ses lignes sont remplies directement
+            for ( intmax_t i = start.y; i < ( start.y + rectangleDim.height ); ++i ) {
+                std::fill_n( view.row( static_cast<size_t>(i) ) + start.x, rectangleDim.width, static_cast<Shade>(color) );
+            }
+            break;
+
+        default :
+            throw imageUtils::invalidEnumTYPE( "The given type was unknown for this function" );
+    }
+}
+
+// Writers
+void GrayImage::writePGM( std::ostream& os, const Format::WRITE_IN f ) const {
+    writePGM( view(), os, f );
+}
+
+void GrayImage::writePGM( const ConstView view, std::ostream& os, const Format::WRITE_IN f ) {
+    using Format = Format::WRITE_IN;
+
+    // Write u=in a fonction verifyFormat( format, goodformat list )
+    if ( ( f != Format::ASCII ) && ( f != Format::BINARY ) ) {
+        throw invalidFormat( "Unknown image format" );
+    }
+
+    // Les nuances ont pu être modifiées par les lignes de la vue, elles sont vérifiées avant l'écriture
+    VERIFY::verifyShades( view.row( 0 ), view.width(), view.height(), view.stride(), view.intensity() );
+
+    if ( f == Format::BINARY ) {
+        // TODO Changer identifier par la variable environnement nom utilisateur
+        imageUtils::ASCII::writePNMHeader( os, "P5", view.width(), view.height(), view.intensity(), '\n' );
+
+
+        // Sans marge, l'image est écrite en une seule fois, sinon ligne par ligne
+        if ( view.stride() == view.width() ) {
+            os.write( reinterpret_cast<const char*>(view.row( 0 )),
+                      static_cast<std::streamsize>(static_cast<size_t>(view.width()) * view.height() * sizeof( Shade )) );
+        }
+        else {
+            for ( size_t y = 0; y < view.height(); ++y ) {
+                os.write( reinterpret_cast<const char*>(view.row( y )),
+                          static_cast<std::streamsize>(view.width() * sizeof( Shade )) );
+            }
+        }
+
+        os << '\n';
+    }
+    else {
+        // Full ASCII format
+        imageUtils::ASCII::writePNMHeader( os, "P2", view.width(), view.height(), view.intensity() );
+
+        // Chaque ligne de l'image commence une nouvelle ligne, aucune ligne ne dépasse 70 caractères
+        imageUtils::ASCII::SampleWriter writer( os, imageUtils::ASCII::pnm_limit_char );
+
+        for ( size_t y = 0; y < view.height(); ++y ) {
+            writer.writeRow( view.row( y ), view.width() );
+        }
+
+        writer.flush();
+    }
+
+    os << std::flush;
+}
+
+void GrayImage::compressJPEG( const ConstView view, jpeg_compress_struct& cinfo, const int quality ) {
+    const auto intensity = view.intensity();
+
+    cinfo.image_width = static_cast<JDIMENSION>(view.width());
+    cinfo.image_height = static_cast<JDIMENSION>(view.height());
+    cinfo.input_components = 1;
+    cinfo.in_color_space = JCS_GRAYSCALE;
+
+    jpeg_set_defaults( &cinfo );
+
+    jpeg_set_quality( &cinfo, quality, true );
+
+    jpeg_start_compress( &cinfo, true );
+
+    // Les lignes sont données directement à la bibliothèque, sauf si les nuances doivent être mises à l'échelle de 255
+    std::vector<Shade> row;
+    // Avec une intensité de 0, toutes les nuances valent déjà 0
+    if ( ( imageUtils::maxIntensity != intensity ) && ( 0 != intensity ) ) {
+        row.resize( static_cast<size_t>(view.width()) );
+    }
+
+    while ( cinfo.next_scanline < cinfo.image_height ) {
+        auto row_pointer = const_cast<JSAMPROW>(view.row( cinfo.next_scanline ));
+
+        if ( !row.empty() ) {
+            for ( size_t x = 0; x < row.size(); ++x ) {
+                row[x] = static_cast<Shade>(( row_pointer[x] * imageUtils::maxIntensity + intensity / 2 ) / intensity);
+            }
+            row_pointer = row.data();
+        }
+
+        jpeg_write_scanlines( &cinfo, &row_pointer, 1 );
+    }
+
+    jpeg_finish_compress( &cinfo );
+}
+
+void GrayImage::writeJPEG( const char* const output, const int quality ) const {
+    verifyJPEGDimension( dimension.width, dimension.height );
+
+    // Le fichier est fermé après la destruction de l'objet compression, même sur une exception
+    StdioFile outfile( output, "wb", "Erreur dans l'ouverture du fichier de sorti" );
+    JPEGCompression compression;
+    jpeg_stdio_dest( &compression.cinfo, outfile.file );
+
+    compressJPEG( view(), compression.cinfo, quality );
+}
+
+void GrayImage::writeJPEG( std::ostream& os, const int quality ) const {
+    writeJPEG( view(), os, quality );
+}
+
+void GrayImage::writeJPEG( const ConstView view, std::ostream& os, const int quality ) {
+    verifyJPEGDimension( view.width(), view.height() );
+
+    // La destination est déclarée avant l'objet compression, qui l'utilise jusqu'à sa destruction
+    JPEGStreamDestination destination( os );
+    JPEGCompression compression;
+    compression.cinfo.dest = &destination.pub;
+
+    compressJPEG( view, compression.cinfo, quality );
+}
+
+/// Read the magic number and the header of a PGM image in the given stream
+/// \exception invalidType if the magic number is not P5 or P2
+/// \exception Same as imageUtils::ASCII::readPNMHeader
+static imageUtils::PNMHeader<> readPGMHeader( std::istream& is ) {
+    // Lecture du nombre magique pour identifier le type d'image
+    std::string type( 2, '\0' );
+    is.read( &type[0], 2 );
+
+    if ( ( type != "P5" ) && ( type != "P2" ) ) {
+        throw invalidType( "Bad format of file" );
+    }
+
+    return imageUtils::ASCII::readPNMHeader( is, type );
+}
+
+// Readers
+std::unique_ptr<GrayImage> GrayImage::readPGM_secured( std::istream& is ) {
+    const auto header = readPGMHeader( is );
+
+    // L'image est construite à la taille de l'en-tête, ses nuances sont écrites une seule fois par la lecture
+    auto image = createGrayImage( imageUtils::Dimension<>{ header.width, header.height }, header.intensity, header.width,
+                                  imageUtils::uninitializedBuffer<Shade>( static_cast<size_t>(header.width) * header.height ),
+                                  imageUtils::VERIFIED::YES );
+    readPGMShades( is, "P5" == header.type, *image );
+
+    return image;
+}
+
+void GrayImage::readPGM( std::istream& is, GrayImage& image ) {
+    const auto header = readPGMHeader( is );
+
+    // Le tampon de l'image est réutilisé s'il est assez grand
+    image.reshape( imageUtils::Dimension<>{ header.width, header.height }, header.intensity );
+    readPGMShades( is, "P5" == header.type, image );
+}
+
+void GrayImage::readPGMShades( std::istream& is, const bool binary, GrayImage& image ) {
+    const auto width = image.dimension.width;
+    const auto height = image.dimension.height;
+
+    // Sans marge, toutes les lignes sont lues d'un seul bloc
+    const bool packed = ( image.stride_ == width );
+    const size_t count = packed ? ( static_cast<size_t>(width) * height ) : width;
+    const size_t blocks = packed ? 1 : height;
+
+    if ( binary ) {
+        for ( size_t y = 0; y < blocks; ++y ) {
+            const auto row = image.pixels_.data() + ( y * image.stride_ );
+            is.read( reinterpret_cast<char*>(row), static_cast<std::streamsize>(count * sizeof( Shade )) );
+
+            // Comme les lecteurs de fichiers projetés, une image tronquée est refusée
+            if ( static_cast<size_t>(is.gcount()) != count ) {
+                throw invalidSizeRepresentationPixel( "The end of stream was reached before reading all pixels" );
+            }
+        }
+
+        // Les nuances en ASCII sont vérifiées à la lecture, il reste les nuances binaires
+        VERIFY::verifyShades( image.pixels_.data(), width, height, image.stride_, image.intensity_ );
+    }
+    else {
+        // P2 format
+        // Les valeurs sont lues par gros blocs, sans passer par l'extraction formatée du flux
+        imageUtils::ASCII::SampleScanner scanner( is );
+        for ( size_t y = 0; y < blocks; ++y ) {
+            scanner.read( image.pixels_.data() + ( y * image.stride_ ), count, image.intensity_ );
+        }
+
+        if ( !scanner.atEnd() ) {
+            throw alwaysData( "Input stream always contain data" );
+        }
+    }
+
+    imageUtils::skip_ONEwhitespace( is );
+
+    imageUtils::verifyStreamContainData( is );
+}
+
+std::unique_ptr<GrayImage> GrayImage::readPGM_secured( const char* const input ) {
+    // Le fichier est projeté en mémoire, l'en-tête est lu directement dans la projection
+    const imageUtils::MappedFile file( input );
+
+    auto cur = file.begin();
+    const auto end = file.end();
+
+    const auto header = imageUtils::MEMORY::readPNMHeader( cur, end );
+
+    if ( ( header.type != "P5" ) && ( header.type != "P2" ) ) {
+        throw invalidType( "Bad format of file" );
+    }
+
+    const auto size = static_cast<size_t>(header.width) * header.height;
+
+    Pixels pixels;
+
+    if ( header.type == "P5" ) {
+        if ( static_cast<size_t>(end - cur) < size ) {
+            throw invalidSizeRepresentationPixel( "The end of file was reached before reading all pixels" );
+        }
+
+        // Une seule copie, de la projection vers le tableau de pixels
+        pixels.assign( cur, cur + size );
+        cur += size;
+    }
+    else {
+        // P2 format
+        pixels = imageUtils::uninitializedBuffer<Shade>( size );
+
+        imageUtils::ASCII::SampleScanner scanner( cur, end );
+        scanner.read( pixels.data(), pixels.size(), header.intensity );
+
+        if ( !scanner.atEnd() ) {
+            throw alwaysData( "Input file always contain data" );
+        }
+
+        cur = end;
+    }
+
+    // Comme ColorImage::readPPM, seuls des blancs ou des commentaires peuvent suivre les pixels
+    imageUtils::MEMORY::skip_comments( cur, end );
+
+    if ( cur != end ) {
+        throw alwaysData( "Input file always contain data" );
+    }
+
+    return createGrayImage( imageUtils::Dimension<>{ header.width, header.height }, header.intensity,
+                            std::move( pixels ) );
+}
+
+std::unique_ptr<GrayImage> GrayImage::decompressJPEG( jpeg_decompress_struct& cinfo ) {
+    jpeg_read_header( &cinfo, true );
+
+    // Seule la composante de gris est décompressée, même pour une image en couleur
+    cinfo.out_color_space = JCS_GRAYSCALE;
+
+    jpeg_start_decompress( &cinfo );
+
+    auto pixels = imageUtils::uninitializedBuffer<Shade>( static_cast<size_t>(cinfo.output_width) * cinfo.output_height );
+
+    readScanlines( cinfo, pixels.data(), cinfo.output_height );
+
+    jpeg_finish_decompress( &cinfo );
+
+    return createGrayImage( imageUtils::Dimension<>{ cinfo.output_width, cinfo.output_height }, imageUtils::maxIntensity,
+                            std::move( pixels ) );
+}
+
+std::unique_ptr<GrayImage> GrayImage::readJPEG( const char* const input ) {
+    StdioFile inputFile( input, "rb", "Erreur lors de l'ouverture du fichier input" );
+    JPEGDecompression decompression;
+    jpeg_stdio_src( &decompression.cinfo, inputFile.file );
+
+    return decompressJPEG( decompression.cinfo );
+}
+
+std::unique_ptr<GrayImage> GrayImage::readJPEG( std::istream& is ) {
+    // La source est déclarée avant l'objet décompression, qui l'utilise jusqu'à sa destruction
+    JPEGSource source( is );
+    JPEGDecompression decompression;
+    decompression.cinfo.src = &source.pub;
+
+    return decompressJPEG( decompression.cinfo );
+}
+
+
+// Scaler
+std::unique_ptr<GrayImage> GrayImage::simpleScale( const imageUtils::Dimension<> newDim ) const {
+    return simpleScale( view(), newDim );
+}
+
+std::unique_ptr<GrayImage> GrayImage::simpleScale( const ConstView view, const imageUtils::Dimension<> newDim ) {
+    imageUtils::VERIFY::verifyWidth( newDim.width, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
+    imageUtils::VERIFY::verifyHeight( newDim.height, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight});
+
+    // Une image aux lignes alignées donne une image aux lignes alignées
+    const auto newStride = ( view.stride() == view.width() ) ? static_cast<size_t>(newDim.width)
+                                                             : imageUtils::alignedStride<Shade>( newDim.width );
+    auto pixels = imageUtils::uninitializedBuffer<Shade>( newStride * newDim.height );
+
+    const auto thisDim = imageUtils::Dimension<Width, Height>{ view.width(), view.height() };
+
+    const auto ratioW = static_cast<long double>(thisDim.width) / newDim.width;
+    const auto ratioH = static_cast<long double>(thisDim.height) / newDim.height;
+
+    // Les colonnes sources ne dépendent pas de la ligne, elles sont calculées une seule fois
+    std::vector<size_t> columns( static_cast<size_t>(newDim.width) );
+    for ( size_t x = 0; x < columns.size(); ++x ) {
+        columns[x] = static_cast<size_t>(x * ratioW);
+    }
+
+    for ( size_t y = 0; y < static_cast<size_t>(newDim.height); ++y ) {
+        const auto source = view.row( static_cast<size_t>(y * ratioH) );
+        const auto destination = pixels.data() + ( newStride * y );
+        for ( size_t x = 0; x < columns.size(); ++x ) {
+            destination[x] = source[columns[x]];
+        }
+    }
+
+    return createGrayImage( newDim, view.intensity(), newStride, std::move( pixels ), imageUtils::VERIFIED::YES );
+}
+
+std::unique_ptr<GrayImage> GrayImage::bilinearScale( const imageUtils::Dimension<> newDim ) const {
+    return bilinearScale( view(), newDim );
+}
+
+std::unique_ptr<GrayImage> GrayImage::bilinearScale( const ConstView view, const imageUtils::Dimension<> newDim ) {
+    // Peut simplifier la valeur de y2 et x2 car la division en bas vaut toujours 1
+    // Car y2 = std::ceil(y) ou bien y2 = y1 + 1 = std::floor(y) + 1
+    // Donc ratioY = (y -y1) / (y2 - y1) = y - y1
+    imageUtils::VERIFY::verifyWidth( newDim.width, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
+    imageUtils::VERIFY::verifyHeight( newDim.height, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
+
+
+    // Une image aux lignes alignées donne une image aux lignes alignées
+    const auto newStride = ( view.stride() == view.width() ) ? static_cast<size_t>(newDim.width)
+                                                             : imageUtils::alignedStride<Shade>( newDim.width );
+    auto pixels = imageUtils::uninitializedBuffer<Shade>( newStride * newDim.height );
+
+    const auto thisDim = imageUtils::Dimension<Width, Height>{ view.width(), view.height() };
+    // The ratioW and ratioH was scale ratio between the new image and the old image
+    const auto ratioW = static_cast<long double>(thisDim.width) / newDim.width;
+    const auto ratioH = static_cast<long double>(thisDim.height) / newDim.height;
+
+    // xp and yp was coordinates of pixels in the new image
+    for ( Height yp = 0; yp < newDim.height; ++yp ) {
+        // We scale the coordinate yp in the scale of the old image
+        const auto y = ( ( (ratioH * yp) - 0.5 ) < 0 ? 0 : ( (ratioH * yp) - 0.5 ) );
+
+        // We determine the boundary of the double y, between two nearest integers
+        // Such as : y1 <= y <= y2
+        const auto y1 = static_cast<Height>( std::floor(y) );
+        const auto y2 = static_cast<Height>( std::ceil(y) < thisDim.height ? std::ceil(y) : ( thisDim.height - 1 ) );
+
+        // We determine the ratio of y between y1 and y2
+        // In the case where y1 == y2, we have a mathematical error for the division, so the result was 0.0
+        const auto ratioY = ( ( y2 != y1 ) ? ( ( y - y1 ) / ( y2 - y1 ) ) : 0.0 );
+
+        // y1 and y2 are in the old image, so its rows are read without verifying each pixel
+        const auto row1 = view.row( y1 );
+        const auto row2 = view.row( y2 );
+        const auto destination = pixels.data() + ( yp * newStride );
+
+        // We do the same process of the coordinate yp, for the coordinate xp
+        for ( Width xp = 0; xp < newDim.width; ++xp ) {
+            const auto x = ( ( ( ratioW * xp ) - 0.5 ) < 0 ? 0 : ( ( ratioW * xp ) - 0.5 ) );
+            const auto x1 = static_cast<Width>( std::floor(x) );
+            const auto x2 = static_cast<Width>( std::ceil(x) < thisDim.width ? std::ceil(x) : ( thisDim.width - 1 ) );
+
+            const auto ratioX = ( ( x2 != x1 ) ? ( ( x - x1 ) / ( x2 - x1 ) ) : 0.0 );
+
+            // We take the gray shade of old image's pixels, who surround the new image's pixel's coordinate of x and y
+            const auto p1 = row1[x1];
+            const auto p2 = row2[x1];
+            const auto p3 = row1[x2];
+            const auto p4 = row2[x2];
+
+            // We apply the bilinear scale's method to the new image's pixel
+            destination[xp] = static_cast<Shade>(std::round(
+                    ( ( 1 - ratioX ) * ( ( ( 1 - ratioY ) * p1 ) + ( ratioY * p2 ) ) ) +
+                    ( ratioX * ( ( ( 1 - ratioY ) * p3 ) + ( ratioY * p4 ) ) ) ));
+        }
+    }
+
+    return createGrayImage( newDim, view.intensity(), newStride, std::move( pixels ), imageUtils::VERIFIED::YES );
+}
+
+
+// Definition of ColorImage's methods
+
+// Public builders
+ColorImage::ColorImage( const intmax_t width, const intmax_t height ) : ColorImage( width, height, defaultIntensity ) {}
+
+ColorImage::ColorImage( const intmax_t width, const intmax_t height, const intmax_t intensity )
+        : ColorImage( width, height, intensity, static_cast<size_t>(std::max<intmax_t>( width, 0 )) ) {}
+
+ColorImage::ColorImage( const intmax_t width, const intmax_t height, const intmax_t intensity, const size_t stride )
+        : width_( static_cast<Width>(width) ), height_( static_cast<Height>(height) ), intensity_(
+        static_cast<Shade>(intensity) ), stride_( stride ) {
+    // Verify all preconditions
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
+    imageUtils::VERIFY::verifyIntensity( intensity, imageUtils::VERIFY::Interval<Shade>{0,imageUtils::maxIntensity} );
+
+    if ( stride_ < width_ ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
+    }
+
+    // fill écrit chaque pixel une seule fois, la marge des lignes reste non initialisée
+    pixels_ = imageUtils::uninitializedBuffer<Color>( stride_ * height_ );
+
+    // Fill the image with the default Color
+    fill( defaultColor );
+}
+
+
+// Private builders
+ColorImage::ColorImage(
+        const intmax_t width, const intmax_t height, const intmax_t intensity, Pixels&& pixels )
+        : ColorImage( width, height, intensity, static_cast<size_t>(std::max<intmax_t>( width, 0 )), std::move( pixels ) ) {}
+
+ColorImage::ColorImage(
+        const intmax_t width, const intmax_t height, const intmax_t intensity, const size_t stride, Pixels&& pixels,
+        const imageUtils::VERIFIED verified )
+        : width_( static_cast<Width>(width) ), height_( static_cast<Height>(height) ), intensity_(
+        static_cast<Shade>(intensity) ), stride_( stride ), pixels_( std::move( pixels ) ) {
+    // Verify all preconditions
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+
+    if ( stride_ < width_ ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
+    }
+
+    imageUtils::ASCII::verifySizeArray( pixels_, stride_ * height_ );
+    imageUtils::VERIFY::verifyIntensity( intensity,
+                                         imageUtils::VERIFY::Interval<Shade>{ 0, imageUtils::maxIntensity } );
+
+    // Les pixels produits par la bibliothèque sont déjà valides
+    // Color est composée de trois nuances contiguës, toutes limitées par l'intensité
+    // La marge des lignes n'est pas initialisée, elle n'est pas vérifiée
+    if ( imageUtils::VERIFIED::NO == verified ) {
+        VERIFY::verifyShades( reinterpret_cast<const Shade*>(pixels_.data()), width_ * size_t{ 3 }, height_,
+                              stride_ * 3, intensity_ );
+    }
+}
+
+// Reshape
+void ColorImage::reshape( const intmax_t width, const intmax_t height ) {
+    reshape( width, height, intensity_ );
+}
+
+void ColorImage::reshape( const intmax_t width, const intmax_t height, const intmax_t intensity ) {
+    // Verify all preconditions
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+    imageUtils::VERIFY::verifyIntensity( intensity,
+                                         imageUtils::VERIFY::Interval<Shade>{ 0, imageUtils::maxIntensity } );
+
+    // Une image aux lignes alignées le reste
+    const size_t newStride = ( stride_ == width_ ) ? static_cast<size_t>(width)
+                                                   : imageUtils::alignedStride<Color>( static_cast<size_t>(width) );
+    const size_t size = newStride * static_cast<size_t>(height);
+
+    // Les anciens pixels ne sont pas conservés : un nouveau tampon évite à resize de les recopier
+    imageUtils::reshapeBuffer( pixels_, size );
+
+    width_ = static_cast<Width>(width);
+    height_ = static_cast<Height>(height);
+    intensity_ = static_cast<Shade>(intensity);
+    stride_ = newStride;
+}
+
+// Getter / Setter
+Color& ColorImage::pixel( const intmax_t x, const intmax_t y ) {
+    VERIFY::verifyPosition( Point{x,y},
+                            VERIFY::Interval<Width>{0,width_},
+                            VERIFY::Interval<Height>{0,height_} );
+
+    // La position est vérifiée, l'indice ne l'est pas une seconde fois
+    return pixels_[( stride_ * static_cast<size_t>(y) ) + static_cast<size_t>(x)];
+}
+
+const Color& ColorImage::pixel( const intmax_t x, const intmax_t y ) const {
+    VERIFY::verifyPosition( Point{x,y},
+                            VERIFY::Interval<Width>{0,width_},
+                            VERIFY::Interval<Height>{0,height_} );
+
+    // La position est vérifiée, l'indice ne l'est pas une seconde fois
+    return pixels_[( stride_ * static_cast<size_t>(y) ) + static_cast<size_t>(x)];
+}
+
+Color* ColorImage::row( const intmax_t y ) {
+    VERIFY::verifyRow( y, height_ );
+
+    return pixels_.data() + ( stride_ * static_cast<size_t>(y) );
+}
+
+const Color* ColorImage::row( const intmax_t y ) const {
+    VERIFY::verifyRow( y, height_ );
+
+    return pixels_.data() + ( stride_ * static_cast<size_t>(y) );
+}
+
+void ColorImage::setRow( const imageUtils::Point start, const Color* const source, const intmax_t count ) {
+    setRow( view(), start, source, count );
+}
+
+void ColorImage::setRow( const View view, const imageUtils::Point start, const Color* const source, const intmax_t count ) {
+    VERIFY::verifySpan( start, count, view.width(), view.height() );
+    VERIFY::verifyShades( reinterpret_cast<const Shade*>(source), static_cast<size_t>(count) * 3, view.intensity() );
+
+    std::memcpy( view.row( static_cast<size_t>(start.y) ) + start.x, source, static_cast<size_t>(count) * sizeof( Color ) );
+}
+
+void ColorImage::getRow( const imageUtils::Point start, Color* const destination, const intmax_t count ) const {
+    getRow( view(), start, destination, count );
+}
+
+void ColorImage::getRow( const ConstView view, const imageUtils::Point start, Color* const destination, const intmax_t count ) {
+    VERIFY::verifySpan( start, count, view.width(), view.height() );
+
+    std::memcpy( destination, view.row( static_cast<size_t>(start.y) ) + start.x, static_cast<size_t>(count) * sizeof( Color ) );
+}
+
+void ColorImage::copyRect( const Color* const source, const size_t stride, const imageUtils::Point start,
+                          const imageUtils::Dimension<> dim ) {
+    copyRect( view(), source, stride, start, dim );
+}
+
+void ColorImage::copyRect( const View view, const Color* const source, const size_t stride, const imageUtils::Point start,
+                          const imageUtils::Dimension<> dim ) {
+    VERIFY::verifyRectangle( start, dim, view.width(), view.height() );
+
+    const auto width = static_cast<size_t>(dim.width);
+    const auto height = static_cast<size_t>(dim.height);
+    if ( stride < width ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
+    }
+
+    // Toutes les lignes sont vérifiées avant la copie, l'image n'est pas modifiée en cas d'erreur
+    for ( size_t y = 0; y < height; ++y ) {
+        VERIFY::verifyShades( reinterpret_cast<const Shade*>(source + ( y * stride )), width * 3, view.intensity() );
+    }
+
+    for ( size_t y = 0; y < height; ++y ) {
+        std::memcpy( view.row( static_cast<size_t>(start.y) + y ) + start.x, source + ( y * stride ), width * sizeof( Color ) );
+    }
+}
+
+// Filler
+void ColorImage::fill( const Color color ) {
+    fill( view(), color );
+}
+
+void ColorImage::fill( const View view, const Color color ) {
+    // Sans marge, tous les pixels sont contigus
+    if ( view.stride() == view.width() ) {
+        std::fill( view.row( 0 ), view.row( 0 ) + ( view.stride() * view.height() ), color );
+        return;
+    }
+
+    view.forEachRow( [color]( Color* const first, Color* const last ) {
+        std::fill( first, last, color );
+    } );
+}
+
+void ColorImage::horizontalLine( const intmax_t x, const intmax_t y, const intmax_t length, const Color color ) {
+    horizontalLine( view(), x, y, length, color );
+}
+
+void ColorImage::horizontalLine(
+        const View view, const intmax_t x, const intmax_t y, const intmax_t length, const Color color ) {
+    VERIFY::verifyPosition( Point{x,y},
+                            VERIFY::Interval<Width>{0,view.width()},
+                            VERIFY::Interval<Height>{0,view.height()} );
+    imageUtils::VERIFY::verifyLength( length, imageUtils::VERIFY::Interval<Width>{0,view.width() - x} );
+    imageUtils::VERIFY::verifyColor( color, Color( view.intensity(), view.intensity(), view.intensity() ) );
+
+    // Les pixels d'une ligne horizontale sont contigus
+    std::fill_n( view.row( static_cast<size_t>(y) ) + x, length, color );
+}
+
+void ColorImage::verticalLine( const intmax_t x, const intmax_t y, const intmax_t length, const Color color ) {
+    verticalLine( view(), x, y, length, color );
+}
+
+void ColorImage::verticalLine(
+        const View view, const intmax_t x, const intmax_t y, const intmax_t length, const Color color ) {
+    VERIFY::verifyPosition( Point{x,y},
+                            VERIFY::Interval<Width>{0,view.width()},
+                            VERIFY::Interval<Height>{0,view.height()} );
+    imageUtils::VERIFY::verifyLength( length, imageUtils::VERIFY::Interval<Height>{0,view.height() - y} );
+    imageUtils::VERIFY::verifyColor( color, Color( view.intensity(), view.intensity(), view.intensity() ) );
+
+    for ( intmax_t j = y; j < ( y + length ); ++j ) {
+        view.row( static_cast<size_t>(j) )[x] = color;
+    }
+}
+
+void ColorImage::rectangle(
+        const intmax_t x, const intmax_t y, const intmax_t width, const intmax_t height, const Color color ) {
+    rectangle( view(), x, y, width, height, color );
+}
+
+void ColorImage::rectangle( const View view, const intmax_t x, const intmax_t y, const intmax_t width,
+                            const intmax_t height, const Color color ) {
+    VERIFY::verifyPosition( Point{x,y},
+                            VERIFY::Interval<Width>{0,view.width()},
+                            VERIFY::Interval<Height>{0,view.height()} );
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{0,view.width() - x} );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{0,view.height() - y} );
+    imageUtils::VERIFY::verifyColor( color, Color( view.intensity(), view.intensity(), view.intensity() ) );
+
+    horizontalLine( view, x, y, width, color );
+    horizontalLine( view, x, ( y - 1 ) + height, width, color );
+
+    verticalLine( view, x, y + 1, height - 2, color );
+    verticalLine( view, ( x - 1 ) + width, y + 1, height - 2, color );
+}
+
+void ColorImage::fillRectangle(
+        const intmax_t x, const intmax_t y, const intmax_t width, const intmax_t height, const Color color ) {
+    fillRectangle( view(), x, y, width, height, color );
+}
+
+void ColorImage::fillRectangle( const View view, const intmax_t x, const intmax_t y, const intmax_t width,
+                                const intmax_t height, const Color color ) {
+    VERIFY::verifyPosition( Point{x,y},
+                            VERIFY::Interval<Width>{0,view.width()},
+                            VERIFY::Interval<Height>{0,view.height()} );
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{0,view.width() - x} );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{0,view.height() - y} );
+    imageUtils::VERIFY::verifyColor( color, Color( view.intensity(), view.intensity(), view.intensity() ) );
+
+    // Le rectangle est vérifié une seule fois, ses lignes sont remplies directement
+    view.region( Point{ x, y }, imageUtils::Dimension<>{ width, height } ).forEachRow(
+            [color]( Color* const first, Color* const last ) {
+                std::fill( first, last, color );
+            } );
+}
+
+// Writers
+void ColorImage::writePPM( std::ostream& os, const Format::WRITE_IN f ) const {
+    writePPM( view(), os, f );
+}
+
+void ColorImage::writePPM( const ConstView view, std::ostream& os, const Format::WRITE_IN f ) {
+    using Format = Format::WRITE_IN;
+
+    if ( ( f != Format::ASCII ) && ( f != Format::BINARY ) ) {
+        throw invalidFormat( "Unknown image format" );
+    }
+
+    // Pas utile de vérifier le max, lors de la création de couleur on vérifie déjà
+//    for ( const auto color : pixels_ ) {
+//        VERIFY::verifyColor( color, Color{intensity_, intensity_, intensity_});
+//    }
+
+    if ( f == Format::BINARY ) {
+        imageUtils::ASCII::writePNMHeader( os, "P6", view.width(), view.height(), view.intensity() );
+
+        // Sans marge, l'image est écrite en une seule fois, sinon ligne par ligne
+        if ( view.stride() == view.width() ) {
+            os.write( reinterpret_cast<const char*>(view.row( 0 )),
+                      static_cast<std::streamsize>(static_cast<size_t>(view.width()) * view.height() * sizeof( Color )) );
+        }
+        else {
+            for ( size_t y = 0; y < view.height(); ++y ) {
+                os.write( reinterpret_cast<const char*>(view.row( y )),
+                          static_cast<std::streamsize>(view.width() * sizeof( Color )) );
+            }
+        }
+
+        os << '\n';
+    }
+    else {
+        // Full ASCII format
+        imageUtils::ASCII::writePNMHeader( os, "P3", view.width(), view.height(), view.intensity() );
+
+        // Chaque ligne de l'image commence une nouvelle ligne, aucune ligne ne dépasse 70 caractères
+        // Color est composée de trois nuances contiguës : rouge, vert, bleu
+        imageUtils::ASCII::SampleWriter writer( os, imageUtils::ASCII::pnm_limit_char );
+
+        for ( size_t y = 0; y < view.height(); ++y ) {
+            writer.writeRow( reinterpret_cast<const Shade*>(view.row( y )), view.width() * size_t{ 3 } );
+        }
+
+        writer.flush();
+    }
+}
+
+/// Write the header of a TARGA image on 24 bits, without color map
+/// \throw invalidEnumTYPE if the given format is not RLE or NO_RLE
+static void writeTGAHeader( std::ostream& os, const Width width, const Height height, const Format::WRITE_IN f,
+                            const bool topOrigin ) {
+    using Format = Format::WRITE_IN;
+    if ( ( f != Format::NO_RLE ) && ( f != Format::RLE ) ) {
+        throw invalidEnumTYPE( "Error the given format was unknown for this function" );
+    }
+
+    imageUtils::VERIFY::verifyFileDimension( width, height, imageUtils::maxFileDimension );
+
+    // oneByte 1 = 0 because no identification information for the image
+    os.put( 0 );
 
     // oneByte 2 = 0 because no color map
     os.put( 0 );
 
-    using Format = Format::WRITE_IN;
-    if ( ( f != Format::NO_RLE ) && ( f != Format::RLE ) ) {
-        throw invalidEnumTYPE( "Error the given format was unknown for this function" );
+    if ( f == Format::NO_RLE ) {
+        // oneByte 3 = 2 because RGB no RLE
+        os.put( 2 );
+    }
+    else {
+        os.put( 10 );
+    }
+
+    // Colormap
+    // oneByte 4,5 = 0
+    os.put( 0 ).put( 0 );
+
+    // oneByte 6,7 = 0
+    os.put( 0 ).put( 0 );
+
+    // oneByte 8 = 0 because no color map
+    os.put( 0 );
+
+    // Spec Image
+
+    // oneByte 9,10 = X origin of image (lo-hi)
+    os.put( 0 ).put( 0 );
+
+    // oneByte 11,12 = Y origin of image (lo-hi)
+    os.put( 0 ).put( 0 );
+
+    // oneByte 13,14 = Image width (lo-hi)
+    os.put( static_cast<char>(width & 0xFF) ).put( static_cast<char>(width >> 8) );
+
+    // oneByte 15,16 = Image height (lo-hi)
+    os.put( static_cast<char>(height & 0xFF) ).put( static_cast<char>(height >> 8) );
+
+    // oneByte 17 = 24 because with use Targa 24 bits
+    os.put( 24 );
+
+    // oneByte 18 = {  bits0-3 = 0000 because 24bits,
+    //              bit4 = 0 because the origin is left
+    //              bit5 = {0,1} its origin of image (lower left, upper left)
+    //              bit6-7 = 00 because the written image is progressive
+    const uint8_t byte18 = topOrigin ? 0b0010'0000 : 0;
+    os.put( static_cast<char>(byte18) );
+
+    // oneByte 18-size in oneByte 1 = Image identification field, but oneByte 1 = 0 so nothing
+    // oneByte 18 - nothing, because no color map
+}
+
+/// Maximum number of pixels in a packet of a RLE TARGA file
+constexpr size_t maxTGAPacket = 128;
+
+/// \returns The maximum number of bytes of a row of width BGR pixels, encoded in RLE
+static size_t worstTGARow( const size_t width ) {
+    // Dans le pire des cas une ligne coûte un octet d'en-tête tous les 128 pixels en plus de ses pixels
+    return ( width * sizeof( Color ) ) + ( ( width + maxTGAPacket - 1 ) / maxTGAPacket );
+}
+
+/// Encode a row of width BGR pixels in RLE packets, the packets are never across two rows
+/// \pre out can hold worstTGARow( width ) bytes
+/// \returns The position after the last written byte
+static Shade* encodeTGARow( const Shade* const row, const size_t width, Shade* out ) {
+    size_t x = 0;
+    while ( x < width ) {
+        const auto pixels = row + ( x * 3 );
+        const auto limit = std::min( maxTGAPacket, width - x );
+        const auto rle = imageUtils::runLength( pixels, limit );
+
+        if ( 1 < rle ) {
+            // Paquet répété : une seule valeur pour rle pixels
+            *out++ = static_cast<Shade>( 0b1000'0000 | ( rle - 1 ) );
+            out = std::copy( pixels, pixels + 3, out );
+            x += rle;
+        }
+        else {
+            // Paquet brut : les pixels jusqu'au prochain pixel égal à son suivant
+            const auto raw = imageUtils::literalLength( pixels, limit );
+
+            *out++ = static_cast<Shade>( raw - 1 );
+            out = std::copy( pixels, pixels + ( raw * 3 ), out );
+            x += raw;
+        }
+    }
+
+    return out;
+}
+
+void ColorImage::writeTGA( std::ostream& os, const Format::WRITE_IN f ) const {
+    writeTGA( view(), os, f );
+}
+
+void ColorImage::writeTGA( const ConstView view, std::ostream& os, const Format::WRITE_IN f ) {
+    // L'origine est en bas à gauche
+    writeTGAHeader( os, view.width(), view.height(), f, false );
+
+    // oneByte 18 - size of Image = pixels
+    // Vérifier la taille de la classe Color
+
+    if ( f == Format::WRITE_IN::NO_RLE ) {
+        // L'origine est en bas à gauche : les lignes sont écrites de la dernière à la première
+        // Chaque ligne est convertie en BGR dans un tampon réutilisé, puis écrite en une seule fois
+        std::vector<Shade> row( view.width() * sizeof( Color ) );
+
+        for ( size_t y = view.height(); 0 < y; --y ) {
+            imageUtils::swapRedBlue( reinterpret_cast<const Shade*>(view.row( y - 1 )),
+                                     row.data(), view.width() );
+
+            os.write( reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()) );
+        }
+    }
+    else {
+        // L'origine est en bas à gauche : les lignes sont encodées de la dernière à la première
+        constexpr size_t chunkSize = 64 * 1024;
+
+        std::vector<Shade> row( view.width() * sizeof( Color ) );
+        std::vector<Shade> packets( chunkSize + worstTGARow( view.width() ) );
+        auto out = packets.data();
+
+        for ( size_t y = view.height(); 0 < y; --y ) {
+            imageUtils::swapRedBlue( reinterpret_cast<const Shade*>(view.row( y - 1 )),
+                                     row.data(), view.width() );
+
+            out = encodeTGARow( row.data(), view.width(), out );
+
+            if ( chunkSize <= static_cast<size_t>(out - packets.data()) ) {
+                os.write( reinterpret_cast<const char*>(packets.data()), out - packets.data() );
+                out = packets.data();
+            }
+        }
+
+        os.write( reinterpret_cast<const char*>(packets.data()), out - packets.data() );
+        os.flush();
+    }
+
+
+    // No dev or ext fields
+    // Maybe add a basic footer
+}
+
+void ColorImage::compressJPEG( const ConstView view, jpeg_compress_struct& cinfo, const int quality ) {
+    cinfo.image_width = view.width();
+    cinfo.image_height = view.height();
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+
+    jpeg_set_defaults( &cinfo );
+
+    jpeg_set_quality( &cinfo, quality, true );
+
+    jpeg_start_compress( &cinfo, true );
+
+    // Color est composée de trois nuances contiguës : rouge, vert, bleu
+    // Les lignes de l'image sont donc données directement à la bibliothèque
+    while ( cinfo.next_scanline < cinfo.image_height ) {
+        auto row_pointer = const_cast<JSAMPROW>(
+                reinterpret_cast<const JSAMPLE*>(view.row( cinfo.next_scanline )));
+
+        jpeg_write_scanlines( &cinfo, &row_pointer, 1 );
+    }
+
+    jpeg_finish_compress( &cinfo );
+}
+
+void ColorImage::writeJPEG( const char* output, const int quality ) const {
+    verifyJPEGDimension( width_, height_ );
+
+    // Le fichier est fermé après la destruction de l'objet compression, même sur une exception
+    StdioFile outfile( output, "wb", "Erreur dans l'ouverture du fichier de sorti" );
+    JPEGCompression compression;
+    jpeg_stdio_dest( &compression.cinfo, outfile.file );
+
+    compressJPEG( view(), compression.cinfo, quality );
+}
+
+void ColorImage::writeJPEG( std::ostream& os, const int quality ) const {
+    writeJPEG( view(), os, quality );
+}
+
+void ColorImage::writeJPEG( const ConstView view, std::ostream& os, const int quality ) {
+    verifyJPEGDimension( view.width(), view.height() );
+
+    // La destination est déclarée avant l'objet compression, qui l'utilise jusqu'à sa destruction
+    JPEGStreamDestination destination( os );
+    JPEGCompression compression;
+    compression.cinfo.dest = &destination.pub;
+
+    compressJPEG( view, compression.cinfo, quality );
+}
+
+void ColorImage::writeJPEG( std::vector<uint8_t>& output, const int quality ) const {
+    verifyJPEGDimension( width_, height_ );
+
+    // La destination est déclarée avant l'objet compression, qui l'utilise jusqu'à sa destruction
+    JPEGVectorDestination destination( output );
+    JPEGCompression compression;
+    compression.cinfo.dest = &destination.pub;
+
+    compressJPEG( view(), compression.cinfo, quality );
+}
+
+// Readers
+/// Read the magic number and the header of a PPM image in the given stream
+/// \exception invalidType if the magic number is not P6 or P3
+/// \exception Same as imageUtils::ASCII::readPNMHeader
+static imageUtils::PNMHeader<> readPPMHeader( std::istream& is ) {
+    std::string type;
+    is >> type;
+
+    if ( ( type != "P6" ) && ( type != "P3" ) ) {
+        throw invalidType( "Bad format of file" );
+    }
+
+    return imageUtils::ASCII::readPNMHeader( is, type );
+}
+
+ColorImage* ColorImage::readPPM( std::istream& is ) {
+    const auto header = readPPMHeader( is );
+
+    // L'image est construite à la taille de l'en-tête, ses pixels sont écrits une seule fois par la lecture
+    std::unique_ptr<ColorImage> image(
+            new ColorImage( header.width, header.height, header.intensity, header.width,
+                            imageUtils::uninitializedBuffer<Color>( static_cast<size_t>(header.width) * header.height ),
+                            imageUtils::VERIFIED::YES ) );
+    readPPMPixels( is, "P6" == header.type, *image );
+
+    return image.release();
+}
+
+void ColorImage::readPPM( std::istream& is, ColorImage& image ) {
+    const auto header = readPPMHeader( is );
+
+    // Le tampon de l'image est réutilisé s'il est assez grand
+    image.reshape( header.width, header.height, header.intensity );
+    readPPMPixels( is, "P6" == header.type, image );
+}
+
+void ColorImage::readPPMPixels( std::istream& is, const bool binary, ColorImage& image ) {
+    const auto width = image.width_;
+    const auto height = image.height_;
+
+    // Sans marge, toutes les lignes sont lues d'un seul bloc
+    const bool packed = ( image.stride_ == width );
+    const size_t count = packed ? ( static_cast<size_t>(width) * height ) : width;
+    const size_t blocks = packed ? 1 : height;
+
+    if ( binary ) {
+        for ( size_t y = 0; y < blocks; ++y ) {
+            is.read( reinterpret_cast<char*>(image.pixels_.data() + ( y * image.stride_ )),
+                     static_cast<std::streamsize>(count * sizeof( Color )) );
+
+            // Comme les lecteurs de fichiers projetés, une image tronquée est refusée
+            if ( static_cast<size_t>(is.gcount()) != ( count * sizeof( Color ) ) ) {
+                throw invalidSizeRepresentationPixel( "The end of stream was reached before reading all pixels" );
+            }
+        }
+
+        // Les nuances en ASCII sont vérifiées à la lecture, il reste les nuances binaires
+        VERIFY::verifyShades( reinterpret_cast<const Shade*>(image.pixels_.data()), width * size_t{ 3 }, height,
+                              image.stride_ * 3, image.intensity_ );
+    }
+    else {
+        // type P3
+        // Les valeurs sont lues par gros blocs, sans passer par l'extraction formatée du flux
+        // Color est composée de trois nuances contiguës : rouge, vert, bleu
+        imageUtils::ASCII::SampleScanner scanner( is );
+        for ( size_t y = 0; y < blocks; ++y ) {
+            scanner.read( reinterpret_cast<Shade*>(image.pixels_.data() + ( y * image.stride_ )), count * 3,
+                          image.intensity_ );
+        }
+
+        if ( !scanner.atEnd() ) {
+            throw alwaysData( "Input stream always contain data" );
+        }
+    }
+
+    imageUtils::skip_ONEwhitespace( is );
+
+    imageUtils::verifyStreamContainData( is );
+}
+
+ColorImage* ColorImage::readPPM( const char* const input ) {
+    // Le fichier est projeté en mémoire, l'en-tête est lu directement dans la projection
+    const imageUtils::MappedFile file( input );
+
+    auto cur = file.begin();
+    const auto end = file.end();
+
+    const auto header = imageUtils::MEMORY::readPNMHeader( cur, end );
+
+    if ( ( header.type != "P6" ) && ( header.type != "P3" ) ) {
+        throw invalidType( "Bad format of file" );
+    }
+
+    const auto size = static_cast<size_t>(header.width) * header.height;
+
+    Pixels pixels;
+
+    if ( header.type == "P6" ) {
+        if ( static_cast<size_t>(end - cur) < ( size * sizeof( Color ) ) ) {
+            throw invalidSizeRepresentationPixel( "The end of file was reached before reading all pixels" );
+        }
+
+        // Une seule copie, de la projection vers le tableau de pixels
+        const auto first = reinterpret_cast<const Color*>(cur);
+        pixels.assign( first, first + size );
+        cur += size * sizeof( Color );
+    }
+    else {
+        // type P3
+        pixels = imageUtils::uninitializedBuffer<Color>( size );
+
+        imageUtils::ASCII::SampleScanner scanner( cur, end );
+        scanner.read( reinterpret_cast<Shade*>(pixels.data()), pixels.size() * 3, header.intensity );
+
+        if ( !scanner.atEnd() ) {
+            throw alwaysData( "Input file always contain data" );
+        }
+
+        cur = end;
+    }
+
+    imageUtils::MEMORY::skip_comments( cur, end );
+
+    if ( cur != end ) {
+        throw alwaysData( "Input file always contain data" );
+    }
+
+    return new ColorImage( header.width, header.height, header.intensity, std::move( pixels ) );
+}
+
+struct ColorMap {
+    uint16_t firstcolor = 0;
+    uint16_t countColor = 0;
+    uint8_t nbBitsColor = 0;
+};
+
+static ColorMap readColorMap( std::istream& is ) {
+    uint16_t firstColor = 0;
+    uint16_t countColor = 0;
+    uint8_t nbBitsColor = 0;
+
+    is.read( reinterpret_cast<char*>(&firstColor), imageUtils::twoBytes );
+    is.read( reinterpret_cast<char*>(&countColor), imageUtils::twoBytes );
+    is.read( reinterpret_cast<char*>(&nbBitsColor), imageUtils::oneByte );
+
+    // TODO Vérification de nbBitsColor {15.16.24.32}
+
+    if ( ( nbBitsColor != 24 ) && ( nbBitsColor != 0 ) ) {
+        throw invalidColor( "Just manage color with 24 bits" );
+    }
+
+    return { firstColor, countColor, nbBitsColor };
+}
+
+static bool holdColorMap( std::istream& is ) {
+    // Other values than 0 or 1, throw exception
+    char containeMap = 2;
+
+    imageUtils::activateExceptionsOn( is );
+    is.get( containeMap );
+
+    if ( ( containeMap != 0 ) && ( containeMap != 1 ) ) {
+        throw invalidColorMapType( "Bad read value of Color Map Type, please verify the given file" );
+    }
+
+    return ( 1 == containeMap );
+}
+
+/// Convert the pixels of a TARGA file into Color
+/// The pixels can be in BGR on 24 bits, an index of the color map on 8 bits, or a black and white shade on 8 bits
+struct TGAPixelDecoder {
+    bool colorMapped;
+    bool blackWhite;
+    const std::vector<Color>& colorMap;
+    uint16_t firstColor;
+
+    /// Convert count pixels of the file into dst
+    /// \throw invalidColorMapType if an index is outside of the color map
+    void decode( const Shade* const src, Color* const dst, const size_t count ) const {
+        if ( colorMapped ) {
+            for ( size_t i = 0; i < count; ++i ) {
+                const auto index = static_cast<size_t>(src[i]) - firstColor;
+
+                if ( ( src[i] < firstColor ) || ( colorMap.size() <= index ) ) {
+                    throw invalidColorMapType( "An index is outside of the color map" );
+                }
+                dst[i] = colorMap[index];
+            }
+        }
+        else if ( blackWhite ) {
+            for ( size_t i = 0; i < count; ++i ) {
+                dst[i].r_ = src[i];
+                dst[i].g_ = src[i];
+                dst[i].b_ = src[i];
+            }
+        }
+        else {
+            imageUtils::swapRedBlue( src, reinterpret_cast<Shade*>(dst), count );
+        }
+    }
+};
+
+/// Read the packets of a RLE TARGA file, by big chunks of the input stream
+/// \warning The reader can read characters after the last packet
+class TGAPacketReader {
+public:
+    explicit TGAPacketReader( std::istream& is ) : is_( is.rdbuf() ), buffer_( chunkSize ) {}
+
+    /// \returns A pointer to the next count bytes, valid up to the next call
+    /// \throw invalidSizeRepresentationPixel if the end of stream was reached before count bytes
+    const Shade* take( const size_t count ) {
+        if ( ( end_ - cur_ ) < count ) {
+            // Un paquet fait au plus 128 pixels de 3 octets, il tient toujours dans le tampon
+            std::copy( buffer_.data() + cur_, buffer_.data() + end_, buffer_.data() );
+            end_ -= cur_;
+            cur_ = 0;
+
+            const auto read = is_->sgetn( reinterpret_cast<char*>(buffer_.data() + end_),
+                                          static_cast<std::streamsize>(buffer_.size() - end_) );
+            end_ += static_cast<size_t>( std::max<std::streamsize>( read, 0 ) );
+
+            if ( end_ < count ) {
+                throw invalidSizeRepresentationPixel( "The end of stream was reached before reading all pixels" );
+            }
+        }
+
+        const auto data = buffer_.data() + cur_;
+        cur_ += count;
+        taken_ += count;
+
+        return data;
+    }
+
+    /// \returns The number of bytes taken since the construction or the last restart
+    std::streamoff taken() const noexcept { return taken_; }
+
+    /// Forget the buffered bytes, after a move of the position of the input stream
+    void restart() noexcept {
+        cur_ = 0;
+        end_ = 0;
+        taken_ = 0;
+    }
+
+private:
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    std::streambuf* is_;
+    std::vector<Shade> buffer_;
+    size_t cur_ = 0;
+    size_t end_ = 0;
+    std::streamoff taken_ = 0;
+};
+
+/// Header of a TARGA image, with its color map
+struct TGAHeader {
+    Width width;
+    Height height;
+    size_t bytesPerPixel;
+    bool colorMapped;
+    bool blackWhite;
+    bool rle;
+    bool topOrigin;
+    uint16_t firstColor;
+    std::vector<Color> colorMap;
+};
+
+/// Read the header of a TARGA image, its identification field and its color map, up to the first pixel
+/// \throw invalidFormat if the format or the size of the pixels is not supported
+/// \throw invalidColorMapType if the color map is not valid
+static TGAHeader readTGAHeader( std::istream& is ) {
+    imageUtils::activateExceptionsOn( is );
+    // 1 Lecture de la taille du champ d'identification
+    uint8_t sizeIdentificationField = 0;
+    is.read( reinterpret_cast<char*>(&sizeIdentificationField), imageUtils::oneByte );
+
+    // 2 Contient une palette de couleur
+    const bool containColormap = holdColorMap( is );
+
+    // 3 Type de l'image
+    // Fonction qui retourne un type TargaFormat, qui comportera une liste des formats targa
+    uint8_t type = 0;
+    is.read( reinterpret_cast<char*>(&type), imageUtils::oneByte );
+
+    // Verification que la type est 2 pour le rgb non compressé
+    // 1 pour le color mapped non compressé
+    // 3 pour le noir et blanc non compressé
+    // 10 rgb rle
+    // 9 color mapped rle
+    // 11 noir et blanc rle
+    const auto format = static_cast<Format::TARGA>(type);
+    const bool isColorMapped = ( Format::TARGA::UNCOMPRESSED_COLOR_MAP == format ) ||
+                               ( Format::TARGA::RLE_COLOR_MAP == format );
+    const bool isTrueColor = ( Format::TARGA::UNCOMPRESSED_TRUE_COLOR == format ) ||
+                             ( Format::TARGA::RLE_TRUE_COLOR == format );
+    const bool isBlackWhite = ( Format::TARGA::UNCOMPRESSED_BLACK_WHITE == format ) ||
+                              ( Format::TARGA::RLE_BLACK_WHITE == format );
+    const bool isRle = ( Format::TARGA::RLE_COLOR_MAP == format ) || ( Format::TARGA::RLE_TRUE_COLOR == format ) ||
+                       ( Format::TARGA::RLE_BLACK_WHITE == format );
+
+    if ( !isColorMapped && !isTrueColor && !isBlackWhite ) {
+        throw invalidFormat( "Only supported formats : 1,2,3,9,10,11" );
+    }
+
+    // 4 Spec de palette couleur
+    const ColorMap colorMap = readColorMap( is );
+
+    // 5 Spec Image
+    uint16_t originX;
+    is.read( reinterpret_cast<char*>(&originX), imageUtils::twoBytes );
+
+    // Verifier l'origine x
+
+    uint16_t originY;
+    is.read( reinterpret_cast<char*>(&originY), imageUtils::twoBytes );
+
+    // Verifier l'origine y
+
+    uint16_t width;
+    is.read( reinterpret_cast<char*>(&width), imageUtils::twoBytes );
+
+    // Vérifier la largeur de l'image
+
+    uint16_t height;
+    is.read( reinterpret_cast<char*>(&height), imageUtils::twoBytes );
+
+    // Vérifier la hauteur de l'image
+
+    uint8_t taille_octet = 0;
+    is.read( reinterpret_cast<char*>(&taille_octet), imageUtils::oneByte );
+
+    // Verification de la taille des pixels
+    // 24 bits pour les vraies couleurs, 8 bits pour les index de palette et le noir et blanc
+    if ( ( isTrueColor && ( taille_octet != 24 ) ) || ( !isTrueColor && ( taille_octet != 8 ) ) ) {
+        throw invalidFormat( "Cette fonction ne prend en charge que des pixels de 24bits, de 8bits" );
+    }
+
+    // Verification du byte 17
+
+    uint8_t descByteImage;
+    is.read( reinterpret_cast<char*>(&descByteImage), imageUtils::oneByte );
+
+    // Verification de la composition du byte 17
+    if ( ( descByteImage & 0b0000'1111 ) != 0 ) {
+        // throw exception only no alpha in 24bits
+    }
+    if ( ( descByteImage & 0b0001'0000 ) != 0 ) {
+        // throw exception only left origin
+    }
+    if ( ( descByteImage & 0b1100'0000 ) != 0 ) {
+        // throw exception on ne gère pas l'entrelacement
+    }
+
+
+    // Lecture du champ d'id
+    std::string idField( sizeIdentificationField, '\0' );
+    if ( sizeIdentificationField > 0 ) {
+        is.read( &idField[0], sizeIdentificationField );
+    }
+
+    // Lecture de la palette, stockée en BGR sur 24 bits
+    // Elle est lue même si l'image n'est pas indexée, pour passer à la suite du fichier
+    std::vector<Color> tabColor( containColormap ? colorMap.countColor : 0 );
+    if ( !tabColor.empty() ) {
+        is.read( reinterpret_cast<char*>(tabColor.data()),
+                 static_cast<std::streamsize>(tabColor.size() * sizeof( Color )) );
+
+        imageUtils::swapRedBlue( reinterpret_cast<const Shade*>(tabColor.data()),
+                                 reinterpret_cast<Shade*>(tabColor.data()), tabColor.size() );
+    }
+
+    if ( isColorMapped && tabColor.empty() ) {
+        throw invalidColorMapType( "Error tab Color is nullptr" );
+    }
+
+    // Origine en bas : la première ligne du fichier est la dernière ligne de l'image
+    const bool topOrigin = ( ( descByteImage & 0b0010'0000 ) == 0b0010'0000 );
+
+    return { width, height, static_cast<size_t>(taille_octet / 8), isColorMapped, isBlackWhite, isRle, topOrigin,
+             colorMap.firstcolor, std::move( tabColor ) };
+}
+
+/// Read a TARGA image by bands of rows, the rows are decoded directly at their place in the given buffer
+/// When the origin is at the bottom, a band of rows is a contiguous band of the file, read from its last row
+class TGARowReader : public RowReader {
+public:
+    TGARowReader( std::istream& is, TGAHeader&& header )
+            : RowReader( header.width, header.height, imageUtils::maxIntensity ), is_( is ),
+              header_( std::move( header ) ), decoder_{ header_.colorMapped, header_.blackWhite, header_.colorMap,
+                                                        header_.firstColor },
+              packets_( is ), start_( is.tellg() ) {}
+
+protected:
+    void decodeRows( Color* const rows, const size_t first, const size_t count ) override {
+        // Les lignes de la bande dans l'ordre du fichier
+        const size_t fileRow = header_.topOrigin ? first : ( height() - first - count );
+
+        if ( fileRow != fileRow_ ) {
+            seek( fileRow );
+        }
+
+        const auto row = [this, rows, count]( const size_t r ) {
+            return rows + ( ( header_.topOrigin ? r : ( count - 1 - r ) ) * width() );
+        };
+
+        if ( !header_.rle ) {
+            buffer_.resize( width() * header_.bytesPerPixel );
+
+            for ( size_t r = 0; r < count; ++r ) {
+                // Lecture directe dans le tampon du flux, comme les paquets RLE : une fin de fichier n'est pas une failure
+                const auto read = is_.rdbuf()->sgetn( reinterpret_cast<char*>(buffer_.data()),
+                                                      static_cast<std::streamsize>(buffer_.size()) );
+                if ( read != static_cast<std::streamsize>(buffer_.size()) ) {
+                    throw invalidSizeRepresentationPixel( "The end of stream was reached before reading all pixels" );
+                }
+
+                decoder_.decode( buffer_.data(), row( r ), width() );
+            }
+        }
+        else {
+            // Les paquets peuvent être à cheval sur deux lignes, ou sur deux bandes : ils sont découpés ligne par ligne
+            for ( size_t r = 0; r < count; ++r ) {
+                size_t x = 0;
+
+                while ( x < width() ) {
+                    if ( 0 == pending_ ) {
+                        nextPacket();
+                    }
+
+                    const auto n = std::min( pending_, width() - x );
+                    if ( repeated_ ) {
+                        std::fill_n( row( r ) + x, n, color_ );
+                    }
+                    else {
+                        decoder_.decode( values_, row( r ) + x, n );
+                        values_ += n * header_.bytesPerPixel;
+                    }
+
+                    pending_ -= n;
+                    x += n;
+                }
+            }
+        }
+
+        fileRow_ = fileRow + count;
     }
 
-    if ( f == Format::NO_RLE ) {
-        // oneByte 3 = 2 because RGB no RLE
-        os.put( 2 );
+private:
+    /// Start of a row in a RLE file : the position of the packet who contains its first pixel,
+    /// and the number of pixels of this packet in the previous row
+    struct RowStart {
+        std::streamoff packet;
+        size_t skipped;
+    };
+
+    std::istream& is_;
+    const TGAHeader header_;
+    const TGAPixelDecoder decoder_;
+    TGAPacketReader packets_;
+
+    /// Position of the first pixel in the stream
+    const std::streamoff start_;
+
+    /// The next row of the file to decode
+    size_t fileRow_ = 0;
+
+    /// Buffer of a row of an image without RLE
+    std::vector<Shade> buffer_;
+
+    /// The current packet of a RLE image, and its number of pixels not yet decoded
+    size_t pending_ = 0;
+    bool repeated_ = false;
+    Color color_;
+    const Shade* values_ = nullptr;
+
+    /// Start of each row of a RLE image, found when it is needed
+    std::vector<RowStart> rowStarts_;
+
+    /// Read the header of the next packet, and its values
+    void nextPacket() {
+        const auto packetHeader = *packets_.take( 1 );
+        pending_ = static_cast<size_t>( ( packetHeader & 0b0111'1111 ) + 1 );
+        repeated_ = ( packetHeader & 0b1000'0000 ) != 0;
+
+        if ( repeated_ ) {
+            // Paquet répété : une seule valeur, recopiée pending_ fois
+            decoder_.decode( packets_.take( header_.bytesPerPixel ), &color_, 1 );
+        }
+        else {
+            // Paquet brut : pending_ valeurs à la suite
+            values_ = packets_.take( pending_ * header_.bytesPerPixel );
+        }
+    }
+
+    /// Move the reading to the start of the given row of the file
+    /// \throw invalidFormat if the input stream is not seekable
+    void seek( const size_t fileRow ) {
+        if ( start_ < 0 ) {
+            throw invalidFormat( "The input stream needs to be seekable to read this image by bands" );
+        }
+
+        if ( !header_.rle ) {
+            is_.seekg( start_ + static_cast<std::streamoff>(fileRow * width() * header_.bytesPerPixel) );
+        }
+        else {
+            if ( rowStarts_.empty() ) {
+                findRowStarts();
+            }
+
+            is_.seekg( rowStarts_[fileRow].packet );
+            packets_.restart();
+
+            // Les pixels du paquet qui appartiennent à la ligne précédente sont ignorés
+            nextPacket();
+            const auto skipped = rowStarts_[fileRow].skipped;
+            pending_ -= skipped;
+            if ( !repeated_ ) {
+                values_ += skipped * header_.bytesPerPixel;
+            }
+        }
+
+        fileRow_ = fileRow;
+    }
+
+    /// Read all the packets of the file, without decoding them, to find the start of each row
+    void findRowStarts() {
+        rowStarts_.resize( height() );
+
+        is_.seekg( start_ );
+        packets_.restart();
+
+        const size_t size = static_cast<size_t>(width()) * height();
+        size_t pixel = 0;
+
+        while ( pixel < size ) {
+            const auto packet = start_ + packets_.taken();
+            const auto packetHeader = *packets_.take( 1 );
+            const auto count = static_cast<size_t>( ( packetHeader & 0b0111'1111 ) + 1 );
+            const bool repeated = ( packetHeader & 0b1000'0000 ) != 0;
+            packets_.take( ( repeated ? 1 : count ) * header_.bytesPerPixel );
+
+            // Toutes les lignes qui commencent dans ce paquet
+            for ( size_t r = ( pixel + width() - 1 ) / width(); ( r < height() ) && ( ( r * width() ) < ( pixel + count ) ); ++r ) {
+                rowStarts_[r] = RowStart{ packet, ( r * width() ) - pixel };
+            }
+
+            pixel += count;
+        }
+
+        pending_ = 0;
+    }
+};
+
+ColorImage* ColorImage::readTGA( std::istream& is ) {
+    // TODO Factoriser le code
+    // TODO Rendre expressif le code avec des appels de fonctions -> abstraction
+
+    /*
+    constexpr size_t lengthFooter = 26;
+    const std::string SIGNATURE("TRUEVISION-XFILE");
+
+    // Move to start of footer
+    is.seekg( -lengthFooter, std::ios_base::end );
+
+    // Read size of dev field
+    intmax_t sizeDevField = -1;
+    is.read( reinterpret_cast<char*>(&sizeDevField), 4);
+    // Vérifier taille >= 0
+
+    // Read size of ext field
+    intmax_t sizeExtField = -1;
+    is.read( reinterpret_cast<char*>(&sizeExtField), 4);
+    // Vérifier taille >= 0
+
+    // Read Signature in footer
+    auto const rawSignature = new char[SIGNATURE.length()];
+    is.read( rawSignature, SIGNATURE.length() );
+
+    // Vérification que l'on a le format Original de Targa
+    if ( rawSignature == SIGNATURE ) {
+        // Récuperer la taille des developpeurs et la taille des extensions
+        //throw invalidFormat( "The format TRUEVISION-XFILES is not supported. Only the ORIGINAL format of Targa");
+    }
+
+
+    // Déplacement au début du fichier
+    is.seekg(0, std::ios_base::beg);
+     */
+
+    auto reader = RowReader::openTGA( is );
+
+    // L'image est construite à la taille de l'en-tête, toutes ses lignes sont lues en une seule bande
+    const size_t count = static_cast<size_t>(reader->width()) * reader->height();
+    std::unique_ptr<ColorImage> image( new ColorImage( reader->width(), reader->height(), maxIntensity, reader->width(),
+                                                       imageUtils::uninitializedBuffer<Color>( count ),
+                                                       imageUtils::VERIFIED::YES ) );
+    reader->readRows( image->pixels_.data(), image->height_ );
+
+    return image.release();
+}
+
+void ColorImage::readTGA( std::istream& is, ColorImage& image ) {
+    // Toute l'image est lue en une seule bande, à partir de la position courante du flux
+    auto reader = RowReader::openTGA( is );
+
+    // Le tampon de l'image est réutilisé s'il est assez grand
+    image.reshape( reader->width(), reader->height(), maxIntensity );
+
+    // Avec une marge, les lignes sont aussi lues en une seule bande, sans marge au début du tampon
+    // Une lecture par ligne recommencerait le déplacement dans le flux des images dont l'origine est en bas
+    const auto pixels = image.pixels_.data();
+    reader->readRows( pixels, image.height_ );
+
+    // Puis elles sont écartées à leur place, de la dernière à la première : une ligne ne recule jamais
+    if ( image.stride_ != image.width_ ) {
+        for ( size_t y = image.height_ - 1; 0 < y; --y ) {
+            const auto packed = pixels + ( y * image.width_ );
+            std::copy_backward( packed, packed + image.width_, pixels + ( y * image.stride_ ) + image.width_ );
+        }
+    }
+}
+
+/// Do nothing except throw, the size of a decompressed JPEG image is valid or both equal to 0
+/// \exception invalidWidth if newWidth does not in ]0; maxWidth]
+/// \exception invalidHeight if newHeight does not in ]0; maxHeight]
+static void verifyJPEGSize( const intmax_t newWidth, const intmax_t newHeight ) {
+    if ( ( 0 != newWidth ) || ( 0 != newHeight ) ) {
+        imageUtils::VERIFY::verifyWidth( newWidth, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
+        imageUtils::VERIFY::verifyHeight( newHeight, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
+    }
+}
+
+ColorImage* ColorImage::decompressJPEG( jpeg_decompress_struct& cinfo, const intmax_t newWidth, const intmax_t newHeight ) {
+    const bool scaled = ( 0 != newWidth ) || ( 0 != newHeight );
+
+    jpeg_read_header(&cinfo, true);
+
+    // Les images en niveaux de gris sont aussi décompressées en RGB
+    cinfo.out_color_space = JCS_RGB;
+
+    // La bibliothèque sait décompresser directement à 1/2, 1/4 ou 1/8 de la taille, dans le domaine DCT
+    // On prend la plus petite taille qui reste au moins aussi grande que celle demandée
+    if ( scaled ) {
+        for ( unsigned int denom = 8; denom > 1; denom /= 2 ) {
+            if ( ( ( cinfo.image_width + denom - 1 ) / denom >= newWidth ) &&
+                 ( ( cinfo.image_height + denom - 1 ) / denom >= newHeight ) ) {
+                cinfo.scale_num = 1;
+                cinfo.scale_denom = denom;
+                break;
+            }
+        }
+    }
+
+    jpeg_start_decompress(&cinfo);
+
+    // Color est composée de trois nuances contiguës : rouge, vert, bleu
+    // Les lignes sont donc décompressées directement dans les pixels de l'image
+    auto array = imageUtils::uninitializedBuffer<Color>( static_cast<size_t>(cinfo.output_width) * cinfo.output_height );
+
+    readScanlines( cinfo, reinterpret_cast<JSAMPLE*>(array.data()), cinfo.output_height );
+
+    jpeg_finish_decompress(&cinfo);
+
+    std::unique_ptr<ColorImage> image( new ColorImage( cinfo.output_width, cinfo.output_height, 255, std::move(array) ) );
+
+    // Le reste du ratio est fait par le redimensionnement bilinéaire
+    if ( scaled && ( ( newWidth != image->width_ ) || ( newHeight != image->height_ ) ) ) {
+        return image->bilinearScale( newWidth, newHeight );
+    }
+
+    return image.release();
+}
+
+ColorImage* ColorImage::readJPEG( const char* input, const intmax_t newWidth, const intmax_t newHeight ) {
+    verifyJPEGSize( newWidth, newHeight );
+
+    StdioFile inputFile( input, "rb", "Erreur lors de l'ouverture du fichier input" );
+    JPEGDecompression decompression;
+    jpeg_stdio_src( &decompression.cinfo, inputFile.file );
+
+    return decompressJPEG( decompression.cinfo, newWidth, newHeight );
+}
+
+ColorImage* ColorImage::readJPEG( std::istream& is, const intmax_t newWidth, const intmax_t newHeight ) {
+    verifyJPEGSize( newWidth, newHeight );
+
+    // La source est déclarée avant l'objet décompression, qui l'utilise jusqu'à sa destruction
+    JPEGSource source( is );
+    JPEGDecompression decompression;
+    decompression.cinfo.src = &source.pub;
+
+    return decompressJPEG( decompression.cinfo, newWidth, newHeight );
+}
+
+ColorImage* ColorImage::readJPEG(
+        const uint8_t* const data, const size_t size, const intmax_t newWidth, const intmax_t newHeight ) {
+    verifyJPEGSize( newWidth, newHeight );
+
+    // La source est déclarée avant l'objet décompression, qui l'utilise jusqu'à sa destruction
+    JPEGSource source( data, size );
+    JPEGDecompression decompression;
+    decompression.cinfo.src = &source.pub;
+
+    return decompressJPEG( decompression.cinfo, newWidth, newHeight );
+}
+
+ColorImage* ColorImage::readMaison2( std::istream& is ) {
+    // Les plans sont lus en une seule fois, puis entrelacés
+    const std::unique_ptr<ColorPlanes> planes( ColorPlanes::readMaison2( is ) );
+
+    return fromPlanes( *planes );
+}
+
+void ColorImage::writeMaison2( std::ostream& os ) const {
+    writeMaison2( view(), os );
+}
+
+void ColorImage::writeMaison2( const ConstView view, std::ostream& os ) {
+    planes( view ).writeMaison2( os );
+}
+
+// Converters
+ColorPlanes ColorImage::planes( const ConstView view ) {
+    const size_t count = static_cast<size_t>(view.width()) * view.height();
+    ColorPlanes planes( view.width(), view.height(), view.intensity(), imageUtils::uninitializedBuffer<Shade>( count * 3 ) );
+
+    Shade* const red = planes.plane( 0 );
+    Shade* const green = planes.plane( 1 );
+    Shade* const blue = planes.plane( 2 );
+
+    // Sans marge, les pixels sont séparés en une seule fois, sinon ligne par ligne
+    if ( view.stride() == view.width() ) {
+        imageUtils::deinterleavePlanes( reinterpret_cast<const Shade*>(view.row( 0 )), red, green, blue, count );
     }
     else {
-        os.put( 10 );
+        for ( size_t y = 0; y < view.height(); ++y ) {
+            const size_t offset = y * view.width();
+            imageUtils::deinterleavePlanes( reinterpret_cast<const Shade*>(view.row( y )),
+                                            red + offset, green + offset, blue + offset, view.width() );
+        }
     }
 
-    // Colormap
-    // oneByte 4,5 = 0
-    os.put( 0 ).put( 0 );
+    return planes;
+}
 
-    // oneByte 6,7 = 0
-    os.put( 0 ).put( 0 );
+ColorImage* ColorImage::fromPlanes( const ColorPlanes& planes ) {
+    return fromPlanes( planes, planes.width() );
+}
 
-    // oneByte 8 = 0 because no color map
-    os.put( 0 );
+ColorImage* ColorImage::fromPlanes( const ColorPlanes& planes, const size_t stride ) {
+    if ( stride < planes.width() ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
+    }
 
-    // Spec Image
+    const size_t count = static_cast<size_t>(planes.width()) * planes.height();
+    auto pixels = imageUtils::uninitializedBuffer<Color>( stride * planes.height() );
 
-    // oneByte 9,10 = X origin of image (lo-hi)
-    os.put( 0 ).put( 0 );
+    // Sans marge, les plans sont entrelacés en une seule fois, sinon ligne par ligne
+    if ( stride == planes.width() ) {
+        imageUtils::interleavePlanes( planes.plane( 0 ), planes.plane( 1 ), planes.plane( 2 ),
+                                      reinterpret_cast<Shade*>(pixels.data()), count );
+    }
+    else {
+        for ( size_t y = 0; y < planes.height(); ++y ) {
+            const size_t offset = y * planes.width();
+            imageUtils::interleavePlanes( planes.plane( 0 ) + offset, planes.plane( 1 ) + offset,
+                                          planes.plane( 2 ) + offset,
+                                          reinterpret_cast<Shade*>(pixels.data() + ( y * stride )), planes.width() );
+        }
+    }
 
-    // oneByte 11,12 = Y origin of image (lo-hi)
-    os.put( 0 ).put( 0 );
+    return new ColorImage( planes.width(), planes.height(), planes.intensity(), stride, std::move( pixels ),
+                           imageUtils::VERIFIED::YES );
+}
 
-    // oneByte 13,14 = Image width
-    os.write( reinterpret_cast<const char*>(&width_), 2 );
+// Scaler
+ColorImage* ColorImage::simpleScale( const intmax_t newWidth, const intmax_t newHeight ) const {
+    return simpleScale( view(), newWidth, newHeight );
+}
 
-    // oneByte 15,16 = Image height
-    os.write( reinterpret_cast<const char*>(&height_), 2 );
+ColorImage* ColorImage::simpleScale( const ConstView view, const intmax_t newWidth, const intmax_t newHeight ) {
+    imageUtils::VERIFY::verifyWidth( newWidth, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
+    imageUtils::VERIFY::verifyHeight( newHeight, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
 
-    // oneByte 17 = 24 because with use Targa 24 bits
-    os.put( 24 );
+    // Une image aux lignes alignées donne une image aux lignes alignées
+    const auto newStride = ( view.stride() == view.width() )
+                           ? static_cast<size_t>(newWidth)
+                           : imageUtils::alignedStride<Color>( static_cast<size_t>(newWidth) );
+    auto pixels = imageUtils::uninitializedBuffer<Color>( newStride * static_cast<size_t>(newHeight) );
 
-    // Mettre la valeur à 0 pour que l'origine soit en bas à gauche
-    // oneByte 18 = {  bits0-3 = 0000 because 24bits,
-    //              bit4 = 0 because the origin is left
-    //              bit5 = {0,1} its origin of image (lower left, upper left)
-    //              bit6-7 = 00 because the written image is progressive
-    const uint8_t byte18 = 0; // Because image start top left
-    os.put( byte18 );
+    const auto ratioW = static_cast<long double>(view.width()) / newWidth;
+    const auto ratioH = static_cast<long double>(view.height()) / newHeight;
 
-    // oneByte 18-size in oneByte 1 = Image identification field, but oneByte 1 = 0 so nothing
-    // oneByte 18 - nothing, because no color map
+    // Les colonnes sources ne dépendent pas de la ligne, elles sont calculées une seule fois
+    std::vector<size_t> columns( static_cast<size_t>(newWidth) );
+    for ( size_t x = 0; x < columns.size(); ++x ) {
+        columns[x] = static_cast<size_t>(x * ratioW);
+    }
 
-    // oneByte 18 - size of Image = pixels
-    // Vérifier la taille de la classe Color
+    for ( size_t y = 0; y < static_cast<size_t>(newHeight); ++y ) {
+        const auto source = view.row( static_cast<size_t>(y * ratioH) );
+        const auto destination = pixels.data() + ( y * newStride );
+        for ( size_t x = 0; x < columns.size(); ++x ) {
+            destination[x] = source[columns[x]];
+        }
+    }
 
-    if ( f == Format::NO_RLE ) {
-        std::vector<Color> swappedPixels( width_ * height_ );
+    return new ColorImage( newWidth, newHeight, view.intensity(), newStride, std::move( pixels ),
+                           imageUtils::VERIFIED::YES );
+}
 
-        for ( size_t y = 0; y < height_; ++y ) {
-            for ( size_t x = 0; x < width_; ++x ) {
-                swappedPixels.at( ( y * width_ ) + x ) = pixels_.at( ( ( height_ - 1 - y ) * width_ ) + x );
-            }
-        }
+ColorImage* ColorImage::bilinearScale( const intmax_t newWidth, const intmax_t newHeight ) const {
+    return bilinearScale( view(), newWidth, newHeight );
+}
 
-        for ( size_t i = 0; i != static_cast<size_t>(width_ * height_); ++i ) {
-            os.put( static_cast<char>(swappedPixels[i].b_) );
-            os.put( static_cast<char>(swappedPixels[i].g_) );
-            os.put( static_cast<char>(swappedPixels[i].r_) );
-        }
-    }
-    else {
-        // On swap les lignes pour pouvoir bien affiché un fichier commençant avec l'origine en bas à gauche
-        std::vector<Color> swappedPixels( width_ * height_ );
+ColorImage* ColorImage::bilinearScale( const ConstView view, const intmax_t newWidth, const intmax_t newHeight ) {
+    // Chaque canal est agrandi sur son plan de nuances contiguës, puis les plans sont entrelacés
+    const std::unique_ptr<ColorPlanes> scaled( planes( view ).bilinearScale( newWidth, newHeight ) );
 
-        for ( size_t y = 0; y < height_; ++y ) {
-            for ( size_t x = 0; x < width_; ++x ) {
-                swappedPixels.at( ( y * width_ ) + x ) = pixels_.at( ( ( height_ - 1 - y ) * width_ ) + x );
-            }
-        }
+    // Une image aux lignes alignées donne une image aux lignes alignées
+    const auto newStride = ( view.stride() == view.width() )
+                           ? static_cast<size_t>(newWidth)
+                           : imageUtils::alignedStride<Color>( static_cast<size_t>(newWidth) );
 
-        const size_t maxLength = width_ * height_;
-        size_t index = 0;
-        Color color;
-        //Color currChunk[128];
-        std::array<Color, 128> currChunk;
+    return fromPlanes( *scaled, newStride );
+}
 
-        while ( index < maxLength ) {
-            bool isRle = false;
-            color = swappedPixels[index];
-            currChunk[0] = color;
+void ColorImage::Behensem2Octants( intmax_t x1, intmax_t y1, intmax_t x2, intmax_t y2, Color color ) {
+    auto x = x1;
+    auto y = y1;
 
-            size_t rle = 1;
+    auto longX = x2 - x1;
+    auto longY = y2 - y1;
 
-            while ( (index + rle) < maxLength ) {
-                if ( (color != swappedPixels[index + rle]) || ( 128 == rle )) {
-                    isRle = (rle > 1);
-                    break;
-                }
-                ++rle;
-            }
+    // Les pixels tracés restent entre le premier et le dernier, seules ces deux positions sont vérifiées
+    const auto image = view();
+    const auto verifyEnds = [&image]( const Point first, const Point last ) {
+        VERIFY::verifyPosition( first, VERIFY::Interval<Width>{0,image.width()}, VERIFY::Interval<Height>{0,image.height()} );
+        VERIFY::verifyPosition( last, VERIFY::Interval<Width>{0,image.width()}, VERIFY::Interval<Height>{0,image.height()} );
+    };
 
-            if ( isRle ) {
-                os.put(static_cast<char>(128 | (rle -1)) );
-                os.put( static_cast<char>(color.b_) );
-                os.put( static_cast<char>(color.g_) );
-                os.put( static_cast<char>(color.r_) );
-            }
-            else {
-                rle = 1;
+    if ( longY < longX ) { // 1er Octant
+        const auto c1 = 2 * ( longY - longX );
+        const auto c2 = 2 * longY;
 
-                while ( (index + rle) < maxLength ) {
-                    if ( ((color != swappedPixels[index + rle]) && (rle < 128)) || (rle < 3)) {
-                        color = swappedPixels[index + rle];
-                        currChunk[rle] = color;
-                    }
-                    else {
-                        if ( color == swappedPixels[index + rle]) {
-                            rle -= 2;
-                        }
-                        break;
-                    }
-                    ++rle;
-                }
+        auto critere = c2 - longX;
 
-                os.put(static_cast<char>(rle - 1) );
-                for ( size_t i =0; i < rle; ++i) {
-                    color = currChunk[i];
-                    os.put( static_cast<char>(color.b_) );
-                    os.put( static_cast<char>(color.g_) );
-                    os.put( static_cast<char>(color.r_) );
-                }
+        // y ne change pas si la ligne monte
+        if ( x <= x2 ) {
+            verifyEnds( Point{ x1, y1 }, Point{ x2, ( longY > 0 ) ? y2 : y1 } );
+        }
+
+        while ( x <= x2 ) {
+            image.row( static_cast<size_t>(y) )[x] = color;
+            if ( critere >= 0 ) { // changement de ligne horizontale
+                y++;
+                critere = critere + c1;
             }
+            else
+                // toujours la même ligne horizontale
+                critere = critere + c2;
 
-            index += rle;
+            x++; // ligne suivante, et recommence
         }
-
-        os.flush();
     }
+    else { // 2eme Octant
+        const auto c1 = 2 * ( longX - longY );
+        const auto c2 = 2 * longX;
 
+        auto critere = c2 - longY;
 
-    // No dev or ext fields
-    // Maybe add a basic footer
-}
+        // x ne change pas si la ligne va vers la gauche
+        if ( y <= y2 ) {
+            verifyEnds( Point{ x1, y1 }, Point{ ( longX > 0 ) ? x2 : x1, y2 } );
+        }
 
-void ColorImage::writeJPEG( const char* output, const int quality ) const {
-    // TODO L'écriture est figée, on ne gère très peu d'exceptions, et c'est l'exemple donnée dans les fichiers du tp
-    std::vector<Shade> buffer(width_ * height_ * 3);
-    for ( size_t i =0; i < (width_ * height_); ++i ) {
-        auto x = i *3;
-        buffer[x] = pixels_[i].r_;
-        buffer[x+1] = pixels_[i].g_;
-        buffer[x+2] = pixels_[i].b_;
-    }
+        while ( y <= y2 ) {
+            image.row( static_cast<size_t>(y) )[x] = color;
+            if ( critere >= 0 ) { // changement de ligne verticale
+                x++;
+                critere = critere + c1;
+            }
+            else
+                // toujours la même ligne verticale
+                critere = critere + c2;
+            y++; // ligne suivante, et recommence
+        }
 
-    FILE* outfile;
-    if ( ( outfile = fopen( output, "wb" ) ) == nullptr ) {
-        throw std::runtime_error( "Erreur dans l'ouverture du fichier de sorti" );
     }
+}
 
-    jpeg_compress_struct cinfo;
-
-    // Activation de l'attrapeur des erreurs
-    jpeg_error_mgr jerr;
-    cinfo.err = jpeg_std_error( &jerr );
+ColorImage* ColorImage::anaglyphe() const {
+    return anaglyphe( view() );
+}
 
-    // Initialisation de l'objet compression
-    jpeg_create_compress( &cinfo );
-    jpeg_stdio_dest( &cinfo, outfile );
+ColorImage* ColorImage::anaglyphe( const ConstView view ) {
+    // Sur les plans, l'anaglyphe ne fait que copier des moitiés de lignes
+    const std::unique_ptr<ColorPlanes> anaglyphe( planes( view ).anaglyphe() );
 
-    cinfo.image_width = width_;
-    cinfo.image_height = height_;
-    cinfo.input_components = 3;
-    cinfo.in_color_space = JCS_RGB;
+    return fromPlanes( *anaglyphe );
+}
 
-    jpeg_set_defaults( &cinfo );
 
-    jpeg_set_quality( &cinfo, quality, true );
+// Definition of ColorPlanes's methods
 
-    jpeg_start_compress( &cinfo, true );
+// Public builder
+ColorPlanes::ColorPlanes( const intmax_t width, const intmax_t height, const intmax_t intensity )
+        : ColorPlanes( width, height, intensity,
+                       Shades( static_cast<size_t>(std::max<intmax_t>( width, 0 )) *
+                               static_cast<size_t>(std::max<intmax_t>( height, 0 )) * 3, Shade{ 0 } ) ) {}
 
-    auto row_stride = width_ * 3;
-    JSAMPROW row_pointer;
+// Private builder
+ColorPlanes::ColorPlanes( const intmax_t width, const intmax_t height, const intmax_t intensity, Shades&& shades )
+        : width_( static_cast<Width>(width) ), height_( static_cast<Height>(height) ),
+          intensity_( static_cast<Shade>(intensity) ), shades_( std::move( shades ) ) {
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+    imageUtils::VERIFY::verifyIntensity( intensity,
+                                         imageUtils::VERIFY::Interval<Shade>{ 0, imageUtils::maxIntensity } );
 
-    while ( cinfo.next_scanline < cinfo.image_height ) {
-        row_pointer = (JSAMPROW)&buffer[cinfo.next_scanline * row_stride];
+    imageUtils::VERIFY::verifySizeArray( shades_, static_cast<size_t>(width_) * height_ * 3 );
+}
 
-        jpeg_write_scanlines( &cinfo, &row_pointer, 1 );
-    }
+// Scaler
+ColorPlanes* ColorPlanes::bilinearScale( const intmax_t newWidth, const intmax_t newHeight ) const {
+    imageUtils::VERIFY::verifyWidth( newWidth, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
+    imageUtils::VERIFY::verifyHeight( newHeight, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
 
-    jpeg_finish_compress( &cinfo );
+    const auto newCount = static_cast<size_t>(newWidth) * static_cast<size_t>(newHeight);
+    auto shades = imageUtils::uninitializedBuffer<Shade>( newCount * 3 );
 
-    // Fermeture du fichier de sortie
-    fclose(outfile);
+    const auto ratioW = static_cast<long double>(width_) / newWidth;
+    const auto ratioH = static_cast<long double>(height_) / newHeight;
 
-    jpeg_destroy_compress( &cinfo );
-}
+    // Les colonnes sources et leurs poids ne dépendent pas de la ligne, ils sont calculés une seule fois
+    std::vector<Width> columns1( static_cast<size_t>(newWidth) );
+    std::vector<Width> columns2( static_cast<size_t>(newWidth) );
+    std::vector<long double> ratiosX( static_cast<size_t>(newWidth) );
 
-// Readers
-ColorImage* ColorImage::readPPM( std::istream& is ) {
-    std::string type;
-    is >> type;
+    for ( size_t xp = 0; xp < static_cast<size_t>(newWidth); ++xp ) {
+        const auto x = ratioW * xp;
+        const auto x1 = static_cast<Width>( std::floor(x) );
+        const auto x2 = static_cast<Width>( std::ceil(x) < width_ ? std::ceil(x) : (width_ - 1) );
 
-    if ( ( type != "P6" ) && ( type != "P3" ) ) {
-        throw invalidType( "Bad format of file" );
+        columns1[xp] = x1;
+        columns2[xp] = x2;
+        ratiosX[xp] = ( ( x2 != x1) ? ( ( x - x1) / ( x2 - x1) ) : 0.0 );
     }
 
-    imageUtils::skip_comments( is );
-    const auto width = imageUtils::ASCII::readWidth<Width>( is );
+    // Formule historique des couleurs, appliquée plan par plan sur des nuances contiguës :
+    // sans décalage d'un demi-pixel ( x = ratioW * xp ), chaque produit est arrondi par scaleShade,
+    // et les sommes sont faites par addShades ( moyenne si la somme dépasse 255 ), d'abord en x puis en y
+    for ( size_t c = 0; c < 3; ++c ) {
+        const Shade* const source = plane( c );
+        Shade* const destination = shades.data() + ( c * newCount );
 
-    imageUtils::skip_comments( is );
-    const auto height = imageUtils::ASCII::readHeight<Height>( is );
+        for ( size_t yp = 0; yp < static_cast<size_t>(newHeight); ++yp ) {
+            const auto y = ratioH * yp;
+            const auto y1 = static_cast<Height>( std::floor(y) );
+            const auto y2 = static_cast<Height>( std::ceil(y) < height_ ? std::ceil(y) : (height_ - 1) );
+            const auto ratioY = ( ( y2 != y1) ? ( ( y - y1) / ( y2 - y1) ) : 0.0 );
 
-    imageUtils::skip_comments( is );
-    const auto intensity = imageUtils::ASCII::readIntensity<Shade>( is );
+            const auto row1 = source + ( static_cast<size_t>(y1) * width_ );
+            const auto row2 = source + ( static_cast<size_t>(y2) * width_ );
+            const auto row = destination + ( yp * static_cast<size_t>(newWidth) );
 
-    imageUtils::skip_ONEwhitespace( is );
+            for ( size_t xp = 0; xp < static_cast<size_t>(newWidth); ++xp ) {
+                const auto ratioX = ratiosX[xp];
 
-    std::vector<Color> pixels( width * height );
+                const auto top = addShades( scaleShade( 1 - ratioX, row1[columns1[xp]] ),
+                                            scaleShade( ratioX, row1[columns2[xp]] ) );
+                const auto bottom = addShades( scaleShade( 1 - ratioX, row2[columns1[xp]] ),
+                                               scaleShade( ratioX, row2[columns2[xp]] ) );
 
-    // Attraper l'exception EOF, badRead(bad bit), fail bit
-    if ( type == "P6" ) {
-        // Expliquer la lecture
-        try {
-            is.read( reinterpret_cast<char*>(pixels.data()),
-                     static_cast<std::streamsize>(width * height * sizeof( Color )) );
-        } catch ( ... ) {
-            std::cerr << "Error occurred on stream";
+                row[xp] = addShades( scaleShade( 1 - ratioY, top ), scaleShade( ratioY, bottom ) );
+            }
         }
     }
-    else {
-        // type P3
-        for ( size_t i = 0; i < ( width * height ); ++i ) {
-            auto r = 0;
-            auto g = 0;
-            auto b = 0;
-            is >> r >> g >> b;
 
-            pixels.at( i ).r_ = static_cast<Shade>(r);
-            pixels.at( i ).g_ = static_cast<Shade>(g);
-            pixels.at( i ).b_ = static_cast<Shade>(b);
-        }
-    }
+    return new ColorPlanes( newWidth, newHeight, intensity_, std::move( shades ) );
+}
 
-    for ( const auto color: pixels ) {
-        VERIFY::verifyColor( color, Color{ intensity, intensity, intensity } );
-    }
+ColorPlanes* ColorPlanes::anaglyphe() const {
+    const size_t demiWidth = width_ / 2;
+    const size_t newCount = demiWidth * height_;
 
-    imageUtils::skip_ONEwhitespace( is );
+    auto shades = imageUtils::uninitializedBuffer<Shade>( newCount * 3 );
 
-    imageUtils::verifyStreamContainData( is );
+    // Le rouge vient de la partie droite, le vert et le bleu de la partie gauche
+    // La dernière colonne d'une largeur impaire est ignorée
+    for ( size_t y = 0; y < height_; ++y ) {
+        const size_t row = y * width_;
+        const size_t newRow = y * demiWidth;
+
+        std::copy_n( plane( 0 ) + row + demiWidth, demiWidth, shades.data() + newRow );
+        std::copy_n( plane( 1 ) + row, demiWidth, shades.data() + newCount + newRow );
+        std::copy_n( plane( 2 ) + row, demiWidth, shades.data() + ( 2 * newCount ) + newRow );
+    }
 
-    return new ColorImage( width, height, intensity, std::move( pixels ) );
+    return new ColorPlanes( static_cast<intmax_t>(demiWidth), height_, maxIntensity, std::move( shades ) );
 }
 
-struct ColorMap {
-    uint16_t firstcolor = 0;
-    uint16_t countColor = 0;
-    uint8_t nbBitsColor = 0;
-};
+// Writer
+void ColorPlanes::writeMaison2( std::ostream& os ) const {
+    imageUtils::VERIFY::verifyFileDimension( width_, height_, imageUtils::maxFileDimension );
 
-static ColorMap readColorMap( std::istream& is ) {
-    uint16_t firstColor = 0;
-    uint16_t countColor = 0;
-    uint8_t nbBitsColor = 0;
+    const std::string comment = std::string( "Image sauvegardée par " ) + ::identifier;
 
-    is.read( reinterpret_cast<char*>(&firstColor), imageUtils::twoBytes );
-    is.read( reinterpret_cast<char*>(&countColor), imageUtils::twoBytes );
-    is.read( reinterpret_cast<char*>(&nbBitsColor), imageUtils::oneByte );
+    os << "Maison2";
+    os.put( static_cast<char>(comment.size()) );
 
-    // TODO Vérification de nbBitsColor {15.16.24.32}
+    // Hauteur puis largeur, poids fort en premier
+    const char dim[4] = { static_cast<char>(height_ >> 8), static_cast<char>(height_ & 0xFF),
+                          static_cast<char>(width_ >> 8), static_cast<char>(width_ & 0xFF) };
+    os.write( dim, sizeof( dim ) );
 
-    if ( ( nbBitsColor != 24 ) && ( nbBitsColor != 0 ) ) {
-        throw invalidColor( "Just manage color with 24 bits" );
+    os << comment;
+
+    // Les plans vert, bleu puis rouge sont écrits chacun en une seule fois
+    const auto count = static_cast<std::streamsize>(static_cast<size_t>(width_) * height_);
+    for ( const size_t index : { 1, 2, 0 } ) {
+        os.write( reinterpret_cast<const char*>(plane( index )), count );
     }
 
-    return { firstColor, countColor, nbBitsColor };
+    os << std::flush;
 }
 
-static bool holdColorMap( std::istream& is ) {
-    // Other values than 0 or 1, throw exception
-    char containeMap = 2;
+// Reader
+ColorPlanes* ColorPlanes::readMaison2( std::istream& is ) {
+    // Vérification du type
+    char type[7] = {};
+    is.read( type, sizeof( type ) );
 
-    imageUtils::activateExceptionsOn( is );
-    is.get( containeMap );
+    if ( std::string( type, sizeof( type ) ) != "Maison2" ) {
+        throw invalidType("The given file is not of type Maison2");
+    }
 
-    if ( ( containeMap != 0 ) && ( containeMap != 1 ) ) {
-        throw invalidColorMapType( "Bad read value of Color Map Type, please verify the given file" );
+    // Lecture de la taille de la zone commentaire
+    uint8_t sizeComments = 0;
+    is.read( reinterpret_cast<char*>(&sizeComments), oneByte);
+
+    // Lecture de la hauteur puis de la largeur, poids fort en premier
+    // Merci https://stackoverflow.com/questions/6090561/how-to-use-high-and-low-bytes/6090641
+    uint8_t dim[4] = {};
+    is.read( reinterpret_cast<char*>(dim), sizeof( dim ) );
+
+    const uint16_t height = (dim[1] | (dim[0] << 8));
+    const uint16_t width = (dim[3] | (dim[2] << 8));
+
+    // Le commentaire est ignoré
+    is.ignore( sizeComments );
+
+    // La suite est des pixels, en trois plans : vert, bleu puis rouge
+    // Chaque plan est lu en une seule fois, directement à sa place
+    const size_t count = static_cast<size_t>(width) * height;
+    auto shades = imageUtils::uninitializedBuffer<Shade>( count * 3 );
+
+    for ( const size_t index : { 1, 2, 0 } ) {
+        is.read( reinterpret_cast<char*>(shades.data() + ( index * count )), static_cast<std::streamsize>(count) );
+
+        if ( static_cast<size_t>(is.gcount()) != count ) {
+            throw invalidSizeRepresentationPixel( "The END OF STREAM was reached before read all pixels" );
+        }
     }
 
-    return ( 1 == containeMap );
+    return new ColorPlanes( width, height, maxIntensity, std::move( shades ) );
 }
 
-ColorImage* ColorImage::readTGA( std::istream& is ) {
-    // TODO Factoriser le code
-    // TODO Rendre expressif le code avec des appels de fonctions -> abstraction
-
-    /*
-    constexpr size_t lengthFooter = 26;
-    const std::string SIGNATURE("TRUEVISION-XFILE");
 
-    // Move to start of footer
-    is.seekg( -lengthFooter, std::ios_base::end );
+// Definition of Image's methods
 
-    // Read size of dev field
-    intmax_t sizeDevField = -1;
-    is.read( reinterpret_cast<char*>(&sizeDevField), 4);
-    // Vérifier taille >= 0
+/// \returns The first sample of the given pixels, where all samples of the pixels are contiguous
+template <typename TPixel>
+static auto samplesOf( TPixel* const pixels ) {
+    using Sample = typename imageUtils::PixelTraits<std::remove_const_t<TPixel>>::Sample;
+    using TSample = std::conditional_t<std::is_const<TPixel>::value, const Sample, Sample>;
 
-    // Read size of ext field
-    intmax_t sizeExtField = -1;
-    is.read( reinterpret_cast<char*>(&sizeExtField), 4);
-    // Vérifier taille >= 0
+    static_assert( sizeof( TPixel ) == ( imageUtils::PixelTraits<std::remove_const_t<TPixel>>::channels * sizeof( Sample ) ),
+                   "The samples of a pixel need to be contiguous" );
 
-    // Read Signature in footer
-    auto const rawSignature = new char[SIGNATURE.length()];
-    is.read( rawSignature, SIGNATURE.length() );
+    return reinterpret_cast<TSample*>(pixels);
+}
 
-    // Vérification que l'on a le format Original de Targa
-    if ( rawSignature == SIGNATURE ) {
-        // Récuperer la taille des developpeurs et la taille des extensions
-        //throw invalidFormat( "The format TRUEVISION-XFILES is not supported. Only the ORIGINAL format of Targa");
+/// Do nothing except throw
+/// \throw invalidShade if a sample of the given pixel is above the given intensity
+template <typename TPixel, typename TSample>
+static void verifyPixel( const TPixel& pixel, const TSample intensity ) {
+    const auto samples = samplesOf( &pixel );
+    for ( size_t c = 0; c < imageUtils::PixelTraits<TPixel>::channels; ++c ) {
+        imageUtils::VERIFY::verifyShade( samples[c], imageUtils::VERIFY::Interval<TSample>{ 0, intensity } );
     }
+}
 
+// Public builders
+template <typename TPixel>
+Image<TPixel>::Image( const intmax_t width, const intmax_t height, const intmax_t intensity )
+        : Image( width, height, intensity, static_cast<size_t>(std::max<intmax_t>( width, 0 )) ) {}
+
+template <typename TPixel>
+Image<TPixel>::Image( const intmax_t width, const intmax_t height, const intmax_t intensity, const size_t stride )
+        : width_( static_cast<Width>(width) ), height_( static_cast<Height>(height) ),
+          intensity_( static_cast<Sample>(intensity) ), stride_( stride ) {
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+    imageUtils::VERIFY::verifyIntensity( intensity,
+                                         imageUtils::VERIFY::Interval<Sample>{ 0, std::numeric_limits<Sample>::max() } );
 
-    // Déplacement au début du fichier
-    is.seekg(0, std::ios_base::beg);
-     */
-
-    imageUtils::activateExceptionsOn( is );
-    // 1 Lecture de la taille du champ d'identification
-    uint8_t sizeIdentificationField = 0;
-    is.read( reinterpret_cast<char*>(&sizeIdentificationField), imageUtils::oneByte );
+    if ( stride_ < width_ ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
+    }
 
-    // 2 Contient une palette de couleur
-    const bool containColormap = holdColorMap( is );
+    // La marge des lignes reste à 0, comme les pixels
+    pixels_.resize( stride_ * height_, TPixel{} );
+}
 
-    // 3 Type de l'image
-    // Fonction qui retourne un type TargaFormat, qui comportera une liste des formats targa
-    uint8_t type = 0;
-    is.read( reinterpret_cast<char*>(&type), imageUtils::oneByte );
+// Private builders
+template <typename TPixel>
+Image<TPixel>::Image( const intmax_t width, const intmax_t height, const intmax_t intensity, const size_t stride,
+                      Pixels&& pixels )
+        : width_( static_cast<Width>(width) ), height_( static_cast<Height>(height) ),
+          intensity_( static_cast<Sample>(intensity) ), stride_( stride ), pixels_( std::move( pixels ) ) {
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+    imageUtils::VERIFY::verifyIntensity( intensity,
+                                         imageUtils::VERIFY::Interval<Sample>{ 0, std::numeric_limits<Sample>::max() } );
 
-    // Verification que la type est 2 pour le rgb non compressé
-    // 1 pour le color mapped non compressé
-    // 10 rgb rle
-    // 9 color mapped rle
-    if ( ( type != 2 ) && ( type != 1 ) ) {
-        throw invalidFormat( "Only supported formats : 1,2" );
+    if ( stride_ < width_ ) {
+        throw invalidLength( "The stride needs to be greater or equal than the width" );
     }
 
-    // 4 Spec de palette couleur
-    const ColorMap colorMap = readColorMap( is );
+    imageUtils::VERIFY::verifySizeArray( pixels_, stride_ * height_ );
+}
 
-    // 5 Spec Image
-    uint16_t originX;
-    is.read( reinterpret_cast<char*>(&originX), imageUtils::twoBytes );
+// Writer
+template <typename TPixel>
+void Image<TPixel>::writePNM( std::ostream& os, const Format::WRITE_IN f ) const {
+    using Format = Format::WRITE_IN;
 
-    // Verifier l'origine x
+    if ( ( f != Format::ASCII ) && ( f != Format::BINARY ) ) {
+        throw invalidFormat( "Unknown image format" );
+    }
 
-    uint16_t originY;
-    is.read( reinterpret_cast<char*>(&originY), imageUtils::twoBytes );
+    for ( size_t y = 0; y < height_; ++y ) {
+        const auto samples = samplesOf( pixels_.data() + ( y * stride_ ) );
+        for ( size_t i = 0; i < ( width_ * channels ); ++i ) {
+            imageUtils::VERIFY::verifyShade( samples[i], imageUtils::VERIFY::Interval<Sample>{ 0, intensity_ } );
+        }
+    }
 
-    // Verifier l'origine y
+    // P5 et P2 pour les nuances de gris, P6 et P3 pour les couleurs
+    const auto type = ( 1 == channels ) ? ( ( f == Format::BINARY ) ? "P5" : "P2" )
+                                        : ( ( f == Format::BINARY ) ? "P6" : "P3" );
 
-    uint16_t width;
-    is.read( reinterpret_cast<char*>(&width), imageUtils::twoBytes );
+    imageUtils::ASCII::writePNMHeader( os, type, width_, height_, intensity_ );
 
-    // Vérifier la largeur de l'image
+    if ( f == Format::BINARY ) {
+        const auto size = imageUtils::BINARY::sampleSize( intensity_ );
 
-    uint16_t height;
-    is.read( reinterpret_cast<char*>(&height), imageUtils::twoBytes );
+        for ( size_t y = 0; y < height_; ++y ) {
+            imageUtils::BINARY::writeSamples( os, samplesOf( pixels_.data() + ( y * stride_ ) ), width_ * channels, size );
+        }
 
-    // Vérifier la hauteur de l'image
+        os << '\n';
+    }
+    else {
+        imageUtils::ASCII::SampleWriter writer( os, imageUtils::ASCII::pnm_limit_char );
 
-    uint8_t taille_octet = 0;
-    is.read( reinterpret_cast<char*>(&taille_octet), imageUtils::oneByte );
+        for ( size_t y = 0; y < height_; ++y ) {
+            writer.writeRow( samplesOf( pixels_.data() + ( y * stride_ ) ), width_ * channels );
+        }
 
-    // Verification de la taille des pixels
-    if ( ( taille_octet != 24 ) && ( taille_octet != 8 ) ) {
-        throw invalidFormat( "Cette fonction ne prend en charge que des pixels de 24bits, de 8bits" );
+        writer.flush();
     }
 
-    // Verification du byte 17
+    os << std::flush;
+}
 
-    uint8_t descByteImage;
-    is.read( reinterpret_cast<char*>(&descByteImage), imageUtils::oneByte );
+// Reader
+template <typename TPixel>
+std::unique_ptr<Image<TPixel>> Image<TPixel>::readPNM( std::istream& is ) {
+    std::string type( 2, '\0' );
+    is.read( &type[0], 2 );
 
-    // Verification de la composition du byte 17
-    if ( ( descByteImage & 0b0000'1111 ) != 0 ) {
-        // throw exception only no alpha in 24bits
-    }
-    if ( ( descByteImage & 0b0001'0000 ) != 0 ) {
-        // throw exception only left origin
-    }
-    if ( ( descByteImage & 0b1100'0000 ) != 0 ) {
-        // throw exception on ne gère pas l'entrelacement
+    const auto binaryType = ( 1 == channels ) ? "P5" : "P6";
+    const auto asciiType = ( 1 == channels ) ? "P2" : "P3";
+
+    if ( ( type != binaryType ) && ( type != asciiType ) ) {
+        throw invalidType( "Bad format of file" );
     }
 
+    // Le même en-tête que GrayImage et ColorImage, l'intensité est lue sur la taille d'un échantillon
+    const auto header = imageUtils::ASCII::readPNMHeader<Sample>( is, type );
+    const auto width = header.width;
+    const auto height = header.height;
+    const auto intensity = header.intensity;
 
-    // Lecture du champ d'id
-    std::string idField;
-    if ( sizeIdentificationField > 0 ) {
-        auto idFieldRAW = new char[sizeIdentificationField];
-        is.read( idFieldRAW, sizeIdentificationField );
+    auto pixels = imageUtils::uninitializedBuffer<TPixel>( static_cast<size_t>(width) * height );
+    const auto samples = samplesOf( pixels.data() );
+    const auto count = pixels.size() * channels;
 
-        idField = std::string( idFieldRAW );
-        delete[] idFieldRAW;
-    }
+    if ( type == binaryType ) {
+        imageUtils::BINARY::readSamples( is, samples, count, imageUtils::BINARY::sampleSize( intensity ) );
 
+        for ( size_t i = 0; i < count; ++i ) {
+            imageUtils::VERIFY::verifyShade( samples[i], imageUtils::VERIFY::Interval<Sample>{ 0, intensity } );
+        }
+    }
+    else {
+        // Le scanner vérifie déjà chaque valeur lue
+        imageUtils::ASCII::SampleScanner scanner( is );
+        scanner.read( samples, count, intensity );
 
-    std::vector<Color> tabColor( colorMap.countColor );
-    if ( containColormap && ( 1 == type ) ) {
-        // lecture de la colormap
-        // Hard fixed to 24bits color
-        is.read( reinterpret_cast<char*>(tabColor.data()),
-                 static_cast<std::streamsize>(colorMap.countColor * sizeof( Color ) ) );
+        if ( !scanner.atEnd() ) {
+            throw alwaysData( "Input stream always contain data" );
+        }
     }
 
-    ColorImage* pimg = nullptr;
+    // Comme ColorImage::readPPM, seul un blanc peut suivre les pixels
+    imageUtils::skip_ONEwhitespace( is );
 
-    std::vector<Color> pixels( width * height );
-    if ( type == 2 ) {
-        is.read( reinterpret_cast<char*>(pixels.data()),
-                 static_cast<std::streamsize>(width * height * sizeof( Color )) );
-        // Origin en haut
-        if ( ( descByteImage & 0b0010'0000 ) == 0b0010'0000 ) {
-            // on swap les lignes
-            std::vector<Color> swappedPixels( width * height );
+    imageUtils::verifyStreamContainData( is );
 
-            for ( size_t y = 0; y < height; ++y ) {
-                for ( size_t x = 0; x < width; ++x ) {
-                    swappedPixels.at( ( y * width ) + x ) = pixels.at( ( ( height - 1 - y ) * width ) + x );
-                }
-            }
+    return std::unique_ptr<Image>( new Image( width, height, intensity, width, std::move( pixels ) ) );
+}
 
-            pimg = new ColorImage( width, height, maxIntensity, std::move( swappedPixels ) );
-        }
-        else {
-            pimg = new ColorImage( width, height, maxIntensity, std::move( pixels ) );
-        }
-    }
-    else if ( type == 1 ) {
-        if ( tabColor.empty() ) {
-            throw invalidColorMapType( "Error tab Color is nullptr" );
-        }
+// Seuls les échantillons de 8 et 16 bits, en nuances de gris ou en couleurs, sont instanciés
+template class Image<Gray8>;
+template class Image<Gray16>;
+template class Image<RGB8>;
+template class Image<RGB16>;
 
-        for ( size_t i = 0; i < ( width * height ); ++i ) {
-            uint8_t c = 0;
-            is.read( reinterpret_cast<char*>(&c), 1 );
 
-            pixels.at( i ) = tabColor[static_cast<size_t>(c)];
-        }
+// Definition of TiledImage's methods
 
-        if ( ( descByteImage & 0b0010'0000 ) == 0b0010'0000 ) {
-            // on swap les lignes
-            std::vector<Color> swappedPixels( width * height );
+// Public builders
+template <typename TPixel>
+TiledImage<TPixel>::TiledImage( const intmax_t width, const intmax_t height, const intmax_t intensity )
+        : width_( static_cast<Width>(width) ), height_( static_cast<Height>(height) ),
+          intensity_( static_cast<Sample>(intensity) ),
+          tilesX_( ( static_cast<size_t>(std::max<intmax_t>( width, 0 )) + tileSize - 1 ) / tileSize ),
+          tilesY_( ( static_cast<size_t>(std::max<intmax_t>( height, 0 )) + tileSize - 1 ) / tileSize ) {
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+    imageUtils::VERIFY::verifyIntensity( intensity,
+                                         imageUtils::VERIFY::Interval<Sample>{ 0, std::numeric_limits<Sample>::max() } );
 
-            for ( size_t y = 0; y < height; ++y ) {
-                for ( size_t x = 0; x < width; ++x ) {
-                    swappedPixels.at( ( y * width ) + x ) = pixels.at( ( ( height - 1 - y ) * width ) + x );
-                }
-            }
+    // Les pixels inutilisés des tuiles du bord restent aussi à 0
+    pixels_.resize( tilesX_ * tilesY_ * tileSize * tileSize, TPixel{} );
+}
 
-            pimg = new ColorImage( width, height, maxIntensity, std::move( swappedPixels ) );
-        }
-        else {
-            pimg = new ColorImage( width, height, maxIntensity, std::move( pixels ) );
+template <typename TPixel>
+TiledImage<TPixel>::TiledImage( const ConstView view )
+        : width_( view.width() ), height_( view.height() ), intensity_( view.intensity() ),
+          tilesX_( ( view.width() + tileSize - 1 ) / tileSize ), tilesY_( ( view.height() + tileSize - 1 ) / tileSize ),
+          pixels_( tilesX_ * tilesY_ * tileSize * tileSize ) {
+    // Chaque ligne d'une tuile est copiée depuis sa ligne dans la vue
+    forEachTile( [&view]( const View tile, const imageUtils::Point origin ) {
+        for ( size_t y = 0; y < tile.height(); ++y ) {
+            std::copy_n( view.row( origin.y + y ) + origin.x, tile.width(), tile.row( y ) );
         }
-    }
+    } );
+}
 
-    return pimg;
+// Getters
+template <typename TPixel>
+typename TiledImage<TPixel>::View TiledImage<TPixel>::tile( const size_t tx, const size_t ty ) {
+    VERIFY::verifyPosition( Point{ static_cast<intmax_t>(tx), static_cast<intmax_t>(ty) },
+                            VERIFY::Interval<intmax_t>{ 0, static_cast<intmax_t>(tilesX_) },
+                            VERIFY::Interval<intmax_t>{ 0, static_cast<intmax_t>(tilesY_) } );
+
+    return tileView( tx, ty );
 }
 
-ColorImage* ColorImage::readJPEG( const char* input ) {
-    FILE* inputFile;
-    if ( (inputFile = fopen(input, "rb")) == nullptr ) {
-        throw std::runtime_error("Erreur lors de l'ouverture du fichier input");
-    }
+template <typename TPixel>
+typename TiledImage<TPixel>::ConstView TiledImage<TPixel>::tile( const size_t tx, const size_t ty ) const {
+    VERIFY::verifyPosition( Point{ static_cast<intmax_t>(tx), static_cast<intmax_t>(ty) },
+                            VERIFY::Interval<intmax_t>{ 0, static_cast<intmax_t>(tilesX_) },
+                            VERIFY::Interval<intmax_t>{ 0, static_cast<intmax_t>(tilesY_) } );
 
-    struct jpeg_decompress_struct cinfo;
+    return tileView( tx, ty );
+}
 
-    struct jpeg_error_mgr jerr;
-    cinfo.err = jpeg_std_error(&jerr);
+template <typename TPixel>
+TPixel& TiledImage<TPixel>::pixel( const intmax_t x, const intmax_t y ) {
+    VERIFY::verifyPosition( Point{ x, y }, VERIFY::Interval<Width>{ 0, width_ }, VERIFY::Interval<Height>{ 0, height_ } );
 
-    jpeg_create_decompress(&cinfo);
-    jpeg_stdio_src(&cinfo, inputFile);
+    const auto column = static_cast<size_t>(x);
+    const auto row = static_cast<size_t>(y);
 
-    jpeg_read_header(&cinfo, true);
+    return tileData( column / tileSize, row / tileSize )[( ( row % tileSize ) * tileSize ) + ( column % tileSize )];
+}
 
-    jpeg_start_decompress(&cinfo);
+template <typename TPixel>
+const TPixel& TiledImage<TPixel>::pixel( const intmax_t x, const intmax_t y ) const {
+    VERIFY::verifyPosition( Point{ x, y }, VERIFY::Interval<Width>{ 0, width_ }, VERIFY::Interval<Height>{ 0, height_ } );
 
-    auto rowstride = cinfo.output_width * cinfo.output_components;
+    const auto column = static_cast<size_t>(x);
+    const auto row = static_cast<size_t>(y);
 
-    std::vector<Shade> buffer( cinfo.image_height * rowstride);
-    JSAMPROW row_pointer;
+    return tileData( column / tileSize, row / tileSize )[( ( row % tileSize ) * tileSize ) + ( column % tileSize )];
+}
 
-    while ( cinfo.output_scanline < cinfo.output_height ) {
-        row_pointer = (JSAMPROW)&buffer[cinfo.output_scanline * rowstride];
+// Fillers
+template <typename TPixel>
+void TiledImage<TPixel>::fill( const TPixel& pixel ) {
+    verifyPixel( pixel, intensity_ );
 
-        jpeg_read_scanlines(&cinfo, &row_pointer, 1);
-    }
+    forEachTile( [&pixel]( const View tile, imageUtils::Point ) {
+        for ( size_t y = 0; y < tile.height(); ++y ) {
+            std::fill( tile.row( y ), tile.row( y ) + tile.width(), pixel );
+        }
+    } );
+}
 
-    jpeg_finish_decompress(&cinfo);
+template <typename TPixel>
+void TiledImage<TPixel>::verticalLine( const intmax_t x, const intmax_t y, const intmax_t length, const TPixel& pixel ) {
+    VERIFY::verifyPosition( Point{ x, y }, VERIFY::Interval<Width>{ 0, width_ }, VERIFY::Interval<Height>{ 0, height_ } );
+    VERIFY::verifyLength( length, VERIFY::Interval<Height>{ 0, height_ - y } );
+    verifyPixel( pixel, intensity_ );
+
+    // Dans une tuile, deux pixels de la colonne ne sont séparés que de tileSize pixels
+    const auto column = static_cast<size_t>(x);
+    auto row = static_cast<size_t>(y);
+    const auto end = row + static_cast<size_t>(length);
 
-    std::vector<Color> array(cinfo.image_width * cinfo.image_height);
-    for ( size_t i = 0; i < (cinfo.image_height * cinfo.image_width); ++i) {
-        auto x = i*3;
+    while ( row < end ) {
+        const auto data = tileData( column / tileSize, row / tileSize ) + ( column % tileSize );
+        const auto last = std::min( end, ( ( row / tileSize ) + 1 ) * tileSize );
 
-        array[i] = Color(buffer[x], buffer[x+1], buffer[x+2]);
+        for ( ; row < last; ++row ) {
+            data[( row % tileSize ) * tileSize] = pixel;
+        }
     }
+}
 
+// Writers
+template <typename TPixel>
+void TiledImage<TPixel>::copyTo( const View view, const imageUtils::Point start ) const {
+    VERIFY::verifyPosition( start, VERIFY::Interval<Width>{ 0, width_ }, VERIFY::Interval<Height>{ 0, height_ } );
+    VERIFY::verifyWidth( view.width(), VERIFY::Interval<Width>{ 0, width_ - start.x } );
+    VERIFY::verifyHeight( view.height(), VERIFY::Interval<Height>{ 0, height_ - start.y } );
+
+    // Chaque ligne est recomposée à partir des lignes des tuiles qu'elle traverse
+    for ( size_t y = 0; y < view.height(); ++y ) {
+        const auto row = static_cast<size_t>(start.y) + y;
+        auto column = static_cast<size_t>(start.x);
+        auto out = view.row( y );
+
+        const auto end = column + view.width();
+        while ( column < end ) {
+            const auto count = std::min( end, ( ( column / tileSize ) + 1 ) * tileSize ) - column;
+            const auto in = tileData( column / tileSize, row / tileSize ) + ( ( row % tileSize ) * tileSize ) +
+                            ( column % tileSize );
+
+            out = std::copy_n( in, count, out );
+            column += count;
+        }
+    }
+}
 
-    auto image = new ColorImage( cinfo.image_width, cinfo.image_height, 255, std::move(array));
+template <typename TPixel>
+void TiledImage<TPixel>::copyTo( const View view ) const {
+    if ( view.width() != width_ ) {
+        throw invalidWidth( "The width of the view needs to be the width of the image" );
+    }
 
-    jpeg_destroy_decompress(&cinfo);
-    fclose(inputFile);
+    if ( view.height() != height_ ) {
+        throw invalidHeight( "The height of the view needs to be the height of the image" );
+    }
 
-    return image;
+    copyTo( view, Point{ 0, 0 } );
 }
 
-ColorImage* ColorImage::readMaison2( std::istream& is ) {
-    // Vérification du type
-    auto p = std::make_unique<char>(7);
-    is.read( p.get(), 7);
-    const std::string type(p.release());
+// Seuls les échantillons de 8 et 16 bits, en nuances de gris ou en couleurs, sont instanciés
+template class TiledImage<Gray8>;
+template class TiledImage<Gray16>;
+template class TiledImage<RGB8>;
+template class TiledImage<RGB16>;
 
-    if ( type != "Maison2" ) {
-        throw invalidType("The given file is not of type Maison2");
-    }
 
-    // Lecture de la taille de la zone commentaire
-    uint8_t sizeComments = 0;
-    is.read( reinterpret_cast<char*>(&sizeComments), oneByte);
+// Definition of RowReader's and RowWriter's methods
 
-    // Lecture de la hauteur
-    uint8_t phHeight = 0;
-    // Lecture du poids fort
-    is.read( reinterpret_cast<char*>(&phHeight), oneByte);
+RowReader::RowReader( const intmax_t width, const intmax_t height, const Shade intensity )
+        : width_( static_cast<Width>(width) ), height_( static_cast<Height>(height) ), intensity_( intensity ) {
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+}
 
-    // Lecture du poids faible
-    uint8_t pfHeight = 0;
-    is.read( reinterpret_cast<char*>(&pfHeight), oneByte);
+size_t RowReader::readRows( Color* const rows, const size_t count ) {
+    const auto n = std::min( count, remainingRows() );
 
-    // Merci https://stackoverflow.com/questions/6090561/how-to-use-high-and-low-bytes/6090641
-    const uint16_t height = (pfHeight | (phHeight << 8));
+    if ( 0 < n ) {
+        decodeRows( rows, next_, n );
+        next_ += n;
+    }
 
-    // Lecture de la largeur
-    uint8_t phWidth = 0;
-    is.read( reinterpret_cast<char*>(&phWidth), oneByte);
+    return n;
+}
 
-    uint8_t pfWidth = 0;
-    is.read( reinterpret_cast<char*>(&pfWidth), oneByte);
+RowWriter::RowWriter( const intmax_t width, const intmax_t height )
+        : width_( static_cast<Width>(width) ), height_( static_cast<Height>(height) ) {
+    imageUtils::VERIFY::verifyWidth( width, imageUtils::VERIFY::Interval<Width>{ 0, imageUtils::maxWidth } );
+    imageUtils::VERIFY::verifyHeight( height, imageUtils::VERIFY::Interval<Height>{ 0, imageUtils::maxHeight } );
+}
 
-    const uint16_t width = (pfWidth | (phWidth << 8));
+void RowWriter::writeRows( const Color* const rows, const size_t count ) {
+    if ( ( height_ - next_ ) < count ) {
+        throw invalidSizeRepresentationPixel( "The written rows go beyond the height of the image" );
+    }
 
-    // Récupération du commentaire et affichage
-    auto str = new char[sizeComments];
-    if ( sizeComments > 0 ) {
-        is.read( str, sizeComments );
-        const std::string comment( str );
+    if ( 0 < count ) {
+        encodeRows( rows, count );
+        next_ += count;
+    }
+}
 
-        std::cout << comment << '\n';
+void RowWriter::finish() {
+    if ( next_ != height_ ) {
+        throw invalidSizeRepresentationPixel( "All the rows of the image were not written" );
     }
-    delete[] str;
 
-    // La suite est des pixels
-    std::vector<Color> pixels(width * height);
+    encodeEnd();
+}
 
-    std::cout << "green\n";
+void RowWriter::copyFrom( RowReader& reader, Color* const buffer, const size_t bufferRows ) {
+    if ( ( reader.width() != width_ ) || ( reader.height() != height_ ) || ( 0 == bufferRows ) ) {
+        throw invalidSizeArray( "The reader and the writer need the same size, and the buffer at least one row" );
+    }
 
-    // Lecture des pixels verts
-    for ( size_t i = 0; i < (width * height); ++i ) {
-        uint8_t green = 0;
-        is.read( reinterpret_cast<char*>(&green), oneByte);
-        pixels.at(i).g_ = green;
+    // Une seule bande de lignes est en mémoire, quelle que soit la taille de l'image
+    size_t n = 0;
+    while ( 0 < ( n = reader.readRows( buffer, bufferRows ) ) ) {
+        writeRows( buffer, n );
     }
 
-    std::cout << "blue\n";
+    finish();
+}
 
-    // Lecture des pixels bleus
-    for ( size_t i = 0; i < (width * height); ++i ) {
-        uint8_t blue = 0;
-        is.read( reinterpret_cast<char*>(&blue), oneByte);
-        pixels.at(i).b_ = blue;
+/// Copy count gray shades in count pixels of three equal shades
+static void grayToColor( const Shade* const src, Color* const dst, const size_t count ) {
+    for ( size_t i = 0; i < count; ++i ) {
+        dst[i].r_ = src[i];
+        dst[i].g_ = src[i];
+        dst[i].b_ = src[i];
     }
+}
 
-    std::cout << "red\n";
+/// Read a PNM image by bands of rows, the rows of a binary image are read directly in the given buffer
+class PNMRowReader : public RowReader {
+public:
+    PNMRowReader( std::istream& is, const std::string& type, const Width width, const Height height,
+                  const Shade intensity )
+            : RowReader( width, height, intensity ), is_( is.rdbuf() ), scanner_( is ),
+              binary_( ( "P5" == type ) || ( "P6" == type ) ), gray_( ( "P2" == type ) || ( "P5" == type ) ),
+              row_( gray_ ? width : 0 ) {}
+
+protected:
+    void decodeRows( Color* const rows, const size_t, const size_t count ) override {
+        if ( !gray_ ) {
+            // Color est composée de trois nuances contiguës : rouge, vert, bleu
+            const auto shades = reinterpret_cast<Shade*>(rows);
+            const auto size = count * width() * sizeof( Color );
+
+            if ( binary_ ) {
+                read( shades, size );
+            }
+            else {
+                scanner_.read( shades, size, intensity() );
+            }
+        }
+        else {
+            for ( size_t r = 0; r < count; ++r ) {
+                if ( binary_ ) {
+                    read( row_.data(), row_.size() );
+                }
+                else {
+                    scanner_.read( row_.data(), row_.size(), intensity() );
+                }
 
-    // Lecture des pixels rouge
-    for ( size_t i = 0; i < (width * height); ++i ) {
-        uint8_t red = 0;
-        is.read( reinterpret_cast<char*>(&red), oneByte);
-        pixels.at(i).r_ = red;
+                grayToColor( row_.data(), rows + ( r * width() ), width() );
+            }
+        }
     }
 
-    std::cout << "fin\n";
-
-    return new ColorImage(width, height, maxIntensity, std::move(pixels));
-}
+private:
+    std::streambuf* is_;
+    imageUtils::ASCII::SampleScanner scanner_;
+    const bool binary_;
+    const bool gray_;
 
-// Scaler
-ColorImage* ColorImage::simpleScale( const intmax_t newWidth, const intmax_t newHeight ) const {
-    imageUtils::VERIFY::verifyWidth( newWidth, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
-    imageUtils::VERIFY::verifyHeight( newHeight, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
+    /// Buffer of a row of a gray image
+    std::vector<Shade> row_;
 
-    auto image = ColorImage::createColorImage( newWidth, newHeight, intensity_ );
+    /// Read size shades of a binary image in one time
+    /// \throw invalidSizeRepresentationPixel if the end of stream was reached before size shades
+    /// \throw invalidShade if a read shade is above the intensity
+    void read( Shade* const shades, const size_t size ) {
+        const auto read = is_->sgetn( reinterpret_cast<char*>(shades), static_cast<std::streamsize>(size) );
 
-    const auto ratioW = static_cast<long double>(width_) / newWidth;
-    const auto ratioH = static_cast<long double>(height_) / newHeight;
+        if ( static_cast<size_t>(std::max<std::streamsize>( read, 0 )) != size ) {
+            throw invalidSizeRepresentationPixel( "The end of stream was reached before reading all pixels" );
+        }
 
-    for ( uint16_t y = 0; y < newHeight; ++y ) {
-        for ( uint16_t x = 0; x < newWidth; ++x ) {
-            image->pixel( x, y ) = pixel( static_cast<uint16_t>(x * ratioW), static_cast<uint16_t>(y * ratioH)
-            );
+        // Avec l'intensité maximale, toutes les nuances sont valides
+        if ( ( imageUtils::maxIntensity != intensity() ) && ( intensity() < *std::max_element( shades, shades + size ) ) ) {
+            throw invalidShade( "Bad shade" );
         }
     }
+};
 
-    return image.release();
+std::unique_ptr<RowReader> RowReader::openPNM( std::istream& is ) {
+    std::string type;
+    is >> type;
+
+    if ( ( type != "P2" ) && ( type != "P3" ) && ( type != "P5" ) && ( type != "P6" ) ) {
+        throw invalidType( "Bad format of file" );
+    }
+
+    imageUtils::skip_comments( is );
+    const auto width = imageUtils::ASCII::readWidth<Width>( is );
+
+    imageUtils::skip_comments( is );
+    const auto height = imageUtils::ASCII::readHeight<Height>( is );
+
+    imageUtils::skip_comments( is );
+    const auto intensity = imageUtils::ASCII::readIntensity<Shade>( is );
+
+    imageUtils::skip_ONEwhitespace( is );
+
+    return std::make_unique<PNMRowReader>( is, type, width, height, intensity );
 }
 
-ColorImage* ColorImage::bilinearScale( const intmax_t newWidth, const intmax_t newHeight ) const {
-    // Peut simplifier la valeur de y2 et x2 car la division en bas vaut toujours 1
-    // Car y2 = std::ceil(y) ou bien y2 = y1 + 1 = std::floor(y) + 1
-    // Donc ratioY = (y -y1) / (y2 - y1) = y - y1
-    imageUtils::VERIFY::verifyWidth( newWidth, imageUtils::VERIFY::Interval<Width>{0,imageUtils::maxWidth} );
+std::unique_ptr<RowReader> RowReader::openTGA( std::istream& is ) {
+    auto header = readTGAHeader( is );
 
-    imageUtils::VERIFY::verifyHeight( newHeight, imageUtils::VERIFY::Interval<Height>{0,imageUtils::maxHeight} );
+    return std::make_unique<TGARowReader>( is, std::move( header ) );
+}
 
-    std::vector<Color> pixels( static_cast<size_t>(newWidth * newHeight) );
+/// The decompressor of the JPEG library, its header is read and the decompression is started
+/// \warning The decompressor can't be moved, the library keeps the address of the source
+struct JPEGDecompressor {
+    // La source est déclarée avant l'objet décompression, qui l'utilise jusqu'à sa destruction
+    JPEGSource source;
+    JPEGDecompression decompression;
 
-    // The ratioW and ratioH was scale ratio between the new image and the old image
-    const auto ratioW = static_cast<long double>(width_) / newWidth;
-    const auto ratioH = static_cast<long double>(height_) / newHeight;
+    /// \exception invalidJPEG if the library reports an error, the decompression object is destroyed
+    explicit JPEGDecompressor( std::istream& is ) : source( is ), decompression() {
+        auto& cinfo = decompression.cinfo;
+        cinfo.src = &source.pub;
 
-    // xp and yp was coordinates of pixels in the new image
-    for ( uint16_t yp = 0; yp < newHeight; ++yp) {
-        // We scale the coordinate yp in the scale of the old image
-        const auto y = ratioH * yp;
+        jpeg_read_header( &cinfo, true );
 
-        // We determine the boundary of the double y, between two nearest integers
-        // Such as : y1 <= y <= y2
-        const auto y1 = static_cast<uint16_t>( std::floor(y) );
-        const auto y2 = static_cast<uint16_t>( std::ceil(y) < height_ ? std::ceil(y) : (height_ - 1) );
+        // Les images en niveaux de gris sont aussi décompressées en RGB
+        cinfo.out_color_space = JCS_RGB;
 
-        // We determine the ratio of y between y1 and y2
-        // In the case where y1 == y2, we have a mathematical error for the division, so the result was 0.0
-        const auto ratioY = ( ( y2 != y1) ? ( ( y - y1) / ( y2 - y1) ) : 0.0 );
+        jpeg_start_decompress( &cinfo );
+    }
+};
 
-        // We do the same process of the coordinate yp, for the coordinate xp
-        for ( uint16_t xp = 0; xp < newWidth; ++xp ) {
-            const auto x = ratioW * xp;
-            const auto x1 = static_cast<uint16_t>( std::floor(x) );
-            const auto x2 = static_cast<uint16_t>( std::ceil(x) < width_ ? std::ceil(x) : (width_ - 1) );
+/// Read a JPEG image by bands of rows, the rows are decompressed directly in the given buffer
+/// The decompressor is a base class, so it is built before the size of the image is given to RowReader
+class JPEGRowReader : private JPEGDecompressor, public RowReader {
+public:
+    explicit JPEGRowReader( std::istream& is )
+            : JPEGDecompressor( is ),
+              RowReader( decompression.cinfo.output_width, decompression.cinfo.output_height, imageUtils::maxIntensity ) {}
 
-            const auto ratioX = ( ( x2 != x1) ? ( ( x - x1) / ( x2 - x1) ) : 0.0 );
+protected:
+    void decodeRows( Color* const rows, const size_t, const size_t count ) override {
+        auto& cinfo = decompression.cinfo;
 
-            // We take the gray shade of old image's pixels, who surround the new image's pixel's coordinate of x and y
-            const auto p1 = pixel(x1, y1);
-            const auto p2 = pixel(x1, y2);
-            const auto p3 = pixel(x2, y1);
-            const auto p4 = pixel(x2, y2);
+        // Color est composée de trois nuances contiguës : rouge, vert, bleu
+        readScanlines( cinfo, reinterpret_cast<JSAMPLE*>(rows), static_cast<JDIMENSION>(count) );
 
-            // We apply the bilinear scale's method to the new image's pixel
-            pixels.at( static_cast<size_t>(xp + ( yp * newWidth )) ) =
-                    ( ( 1 - ratioY ) * ( ( ( 1 - ratioX ) * p1 ) + ( ratioX * p3 ) ) ) +
-                    ( ratioY * ( ( ( 1 - ratioX ) * p2 ) + ( ratioX * p4 ) ) );
+        if ( cinfo.output_scanline == cinfo.output_height ) {
+            jpeg_finish_decompress( &cinfo );
         }
     }
+};
 
-    return new ColorImage(newWidth, newHeight, intensity_, std::move(pixels));
+std::unique_ptr<RowReader> RowReader::openJPEG( std::istream& is ) {
+    return std::make_unique<JPEGRowReader>( is );
 }
 
-void ColorImage::Behensem2Octants( intmax_t x1, intmax_t y1, intmax_t x2, intmax_t y2, Color color ) {
-    auto x = x1;
-    auto y = y1;
+/// Write a PNM image by bands of rows, P6 or P3
+class PNMRowWriter : public RowWriter {
+public:
+    PNMRowWriter( std::ostream& os, const intmax_t width, const intmax_t height, const Shade intensity,
+                  const Format::WRITE_IN f )
+            : RowWriter( width, height ), os_( os ), binary_( Format::WRITE_IN::BINARY == f ),
+              writer_( os, imageUtils::ASCII::pnm_limit_char ) {
+        if ( ( f != Format::WRITE_IN::ASCII ) && ( f != Format::WRITE_IN::BINARY ) ) {
+            throw invalidFormat( "Unknown image format" );
+        }
 
-    auto longX = x2 - x1;
-    auto longY = y2 - y1;
+        imageUtils::ASCII::writePNMHeader( os, binary_ ? "P6" : "P3", static_cast<size_t>(width), static_cast<size_t>(height),
+                                           intensity );
+    }
 
-    if ( longY < longX ) { // 1er Octant
-        const auto c1 = 2 * ( longY - longX );
-        const auto c2 = 2 * longY;
+protected:
+    void encodeRows( const Color* const rows, const size_t count ) override {
+        if ( binary_ ) {
+            os_.write( reinterpret_cast<const char*>(rows), static_cast<std::streamsize>(count * width() * sizeof( Color )) );
+        }
+        else {
+            // Chaque ligne de l'image commence une nouvelle ligne, aucune ligne ne dépasse 70 caractères
+            for ( size_t r = 0; r < count; ++r ) {
+                writer_.writeRow( reinterpret_cast<const Shade*>(rows + ( r * width() )), width() * size_t{ 3 } );
+            }
+        }
+    }
 
-        auto critere = c2 - longX;
+    void encodeEnd() override {
+        if ( binary_ ) {
+            os_ << '\n';
+        }
+        else {
+            writer_.flush();
+        }
 
-        while ( x <= x2 ) {
-            pixel( x, y ) = color;
-            if ( critere >= 0 ) { // changement de ligne horizontale
-                y++;
-                critere = critere + c1;
-            }
-            else
-                // toujours la même ligne horizontale
-                critere = critere + c2;
+        os_.flush();
+    }
 
-            x++; // ligne suivante, et recommence
+private:
+    std::ostream& os_;
+    const bool binary_;
+    imageUtils::ASCII::SampleWriter writer_;
+};
+
+std::unique_ptr<RowWriter> RowWriter::createPNM( std::ostream& os, const intmax_t width, const intmax_t height,
+                                                 const Shade intensity, const Format::WRITE_IN f ) {
+    return std::make_unique<PNMRowWriter>( os, width, height, intensity, f );
+}
+
+/// Write a TARGA image by bands of rows, its origin is at the top
+class TGARowWriter : public RowWriter {
+public:
+    TGARowWriter( std::ostream& os, const intmax_t width, const intmax_t height, const Format::WRITE_IN f )
+            : RowWriter( width, height ), os_( os ), rle_( Format::WRITE_IN::RLE == f ),
+              row_( static_cast<size_t>(width) * sizeof( Color ) ) {
+        writeTGAHeader( os, static_cast<Width>(width), static_cast<Height>(height), f, true );
+
+        if ( rle_ ) {
+            packets_.resize( chunkSize + worstTGARow( static_cast<size_t>(width) ) );
+            out_ = packets_.data();
         }
     }
-    else { // 2eme Octant
-        const auto c1 = 2 * ( longX - longY );
-        const auto c2 = 2 * longX;
 
-        auto critere = c2 - longY;
+protected:
+    void encodeRows( const Color* const rows, const size_t count ) override {
+        for ( size_t r = 0; r < count; ++r ) {
+            // Chaque ligne est convertie en BGR dans un tampon réutilisé
+            imageUtils::swapRedBlue( reinterpret_cast<const Shade*>(rows + ( r * width() )), row_.data(), width() );
 
-        while ( y <= y2 ) {
-            pixel( x, y ) = color;
-            if ( critere >= 0 ) { // changement de ligne verticale
-                x++;
-                critere = critere + c1;
+            if ( !rle_ ) {
+                os_.write( reinterpret_cast<const char*>(row_.data()), static_cast<std::streamsize>(row_.size()) );
             }
-            else
-                // toujours la même ligne verticale
-                critere = critere + c2;
-            y++; // ligne suivante, et recommence
+            else {
+                out_ = encodeTGARow( row_.data(), width(), out_ );
+
+                if ( chunkSize <= static_cast<size_t>(out_ - packets_.data()) ) {
+                    os_.write( reinterpret_cast<const char*>(packets_.data()), out_ - packets_.data() );
+                    out_ = packets_.data();
+                }
+            }
+        }
+    }
+
+    void encodeEnd() override {
+        if ( rle_ ) {
+            os_.write( reinterpret_cast<const char*>(packets_.data()), out_ - packets_.data() );
+            out_ = packets_.data();
         }
 
+        os_.flush();
     }
+
+private:
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    std::ostream& os_;
+    const bool rle_;
+    std::vector<Shade> row_;
+    std::vector<Shade> packets_;
+    Shade* out_ = nullptr;
+};
+
+std::unique_ptr<RowWriter> RowWriter::createTGA( std::ostream& os, const intmax_t width, const intmax_t height,
+                                                 const Format::WRITE_IN f ) {
+    return std::make_unique<TGARowWriter>( os, width, height, f );
 }
 
-ColorImage* ColorImage::anaglyphe() const {
-    const size_t demiWidth = width_ / 2;
+/// Write a JPEG image by bands of rows, the rows are given directly to the library
+class JPEGRowWriter : public RowWriter {
+public:
+    JPEGRowWriter( std::ostream& os, const intmax_t width, const intmax_t height, const int quality )
+            : RowWriter( width, height ), destination_( os ), compression_() {
+        verifyJPEGDimension( width, height );
 
-    std::vector<Color> pixels(demiWidth * height_);
+        auto& cinfo = compression_.cinfo;
+        cinfo.dest = &destination_.pub;
 
-    for ( size_t y = 0; y < height_; ++y ) {
-        // On navigue dans la partie gauche de l'image
-        for ( size_t x = 0; x < demiWidth; ++x ) {
-            // On supprime le canal rouge
-            Color color = pixel( static_cast<intmax_t>(x),
-                                 static_cast<intmax_t>(y));
-            color.r_ = 0;
-            pixels.at( (y * demiWidth) + x) = color;
-        }
+        cinfo.image_width = static_cast<JDIMENSION>(width);
+        cinfo.image_height = static_cast<JDIMENSION>(height);
+        cinfo.input_components = 3;
+        cinfo.in_color_space = JCS_RGB;
+
+        jpeg_set_defaults( &cinfo );
+
+        jpeg_set_quality( &cinfo, quality, true );
+
+        jpeg_start_compress( &cinfo, true );
+    }
+
+protected:
+    void encodeRows( const Color* const rows, const size_t count ) override {
+        constexpr size_t linesPerCall = 16;
+
+        // Color est composée de trois nuances contiguës : rouge, vert, bleu
+        JSAMPROW lines[linesPerCall];
+        for ( size_t r = 0; r < count; r += linesPerCall ) {
+            const auto n = std::min( linesPerCall, count - r );
+            for ( size_t i = 0; i < n; ++i ) {
+                lines[i] = const_cast<JSAMPROW>(reinterpret_cast<const JSAMPLE*>(rows + ( ( r + i ) * width() )));
+            }
 
-        // On navigue dans la partie droite de l'image
-        for ( size_t x = demiWidth; x < width_; ++x ) {
-            // On supprime les canaux vert et bleu
-            Color color = pixel( static_cast<intmax_t>(x),
-                                 static_cast<intmax_t>(y));
-            color.g_ = 0;
-            color.b_ = 0;
-            pixels.at( (y * demiWidth) + (x-demiWidth)) = pixels.at( (y * demiWidth) + (x-demiWidth)) + color;
+            jpeg_write_scanlines( &compression_.cinfo, lines, static_cast<JDIMENSION>(n) );
         }
     }
 
-    return new ColorImage(demiWidth, height_, maxIntensity, std::move(pixels));
+    void encodeEnd() override {
+        jpeg_finish_compress( &compression_.cinfo );
+    }
+
+private:
+    // La destination est déclarée avant l'objet compression, qui l'utilise jusqu'à sa destruction
+    JPEGStreamDestination destination_;
+    JPEGCompression compression_;
+};
+
+std::unique_ptr<RowWriter> RowWriter::createJPEG( std::ostream& os, const intmax_t width, const intmax_t height,
+                                                  const int quality ) {
+    return std::make_unique<JPEGRowWriter>( os, width, height, quality );
 }
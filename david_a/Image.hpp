@@ -6,20 +6,45 @@
 #define CORR_PPMASCII //P3
 #define CORR_READCOLORJPEG
 #define CORR_WRITECOLORJPEG
-//#define CORR_READCOLORTGARLE
+#define CORR_READCOLORTGARLE
 // #define CORR_BRESENHAM
 // #define CORR_TEMPLATE
 
+// Option de taille, à définir aussi à la compilation de Image.cpp, par exemple avec -DIMAGE_LARGE_DIMENSIONS
+// Avec cette option, la largeur et la hauteur sont codées sur 32 bits au lieu de 16
+// #define IMAGE_LARGE_DIMENSIONS
+
+// Option de partage, à définir aussi à la compilation de Image.cpp, par exemple avec -DIMAGE_SHARED_PIXELS
+// Avec cette option, la copie d'une image partage ses pixels, ils ne sont copiés qu'à la première modification
+// #define IMAGE_SHARED_PIXELS
+
 #include <iostream>
 #include <vector>
 #include <limits>
 #include <memory>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <atomic>
+#include <iterator>
+
+// Structures of the JPEG library, only used by reference
+struct jpeg_compress_struct;
+struct jpeg_decompress_struct;
 
 extern const char* const identifier;
 extern const char* const informations;
 
+#ifdef IMAGE_LARGE_DIMENSIONS
+/// The width and the height of the large images, as the gigapixel mosaics, are coded on four bytes
+/// \warning TARGA and Maison2 code the dimension on two bytes, JPEG is limited to 65500 pixels
+using Width = uint32_t;
+using Height = uint32_t;
+#else
 using Width = uint16_t;
 using Height = uint16_t;
+#endif
 using Shade = uint8_t;
 
 
@@ -31,6 +56,10 @@ namespace imageUtils {
     /// Enumeration that indicates whether a shape should be drawn filled or empty
     using FILL = BOOLEAN_TYPE;
 
+    /// Enumeration that indicates whether the pixels given to an image were produced by the library
+    /// Such pixels are already in [0; intensity], they are not verified again
+    using VERIFIED = BOOLEAN_TYPE;
+
     /// Enumeration that indicates if a line should be drawn horizontally or vertically
     enum class TYPE {
         HORIZONTAL, VERTICAL
@@ -51,6 +80,491 @@ namespace imageUtils {
         TWidth width;
         THeight height;
     };
+
+    /// Alignment in bytes of the pixels of the images, and of their rows when the stride is aligned
+    /// It is the size of a cache line, and of the largest vector registers
+    constexpr size_t rowAlignment = 64;
+
+    /// Pool of the big buffers of pixels, shared by all the images
+    /// A freed buffer is kept in the pool, by size class, and given again to the next buffer of the same class
+    /// So the readers and the scalers of a batch of images don't map and unmap their pixels at each call
+    /// \note The buffers under minPooledSize bytes are not pooled, they are allocated and freed directly
+    /// \note The buffers of at least hugePageSize bytes are aligned on huge pages, and advised to use them
+    /// \note All methods can be called by several threads
+    class BufferPool {
+    public:
+        /// Counters of the pool, since the start of the program
+        struct Statistics {
+            /// Number of allocations of pooled buffers
+            size_t allocations;
+
+            /// Number of allocations given a buffer kept in the pool
+            size_t reuses;
+
+            /// Number of freed buffers who were not kept, because of the capacity
+            size_t discards;
+
+            /// Number of allocated buffers advised to use huge pages
+            size_t hugePageBuffers;
+
+            /// Number and size of the buffers kept in the pool, now
+            size_t cachedBuffers;
+            size_t cachedBytes;
+        };
+
+        /// Size of the smallest pooled buffer, smaller buffers are cheap for malloc
+        static constexpr size_t minPooledSize = 128 * 1024;
+
+        /// Size of a huge page, the buffers of at least this size are aligned on it
+        static constexpr size_t hugePageSize = 2 * 1024 * 1024;
+
+        /// Default maximal size of the buffers kept in the pool
+        static constexpr size_t defaultCapacity = 256 * 1024 * 1024;
+
+        BufferPool() = delete;
+
+        /// \return A buffer of at least the given size, aligned on the given alignment
+        /// \warning The content of the buffer is not initialized
+        /// \exception std::bad_alloc if the memory allocation fails
+        static void* allocate( size_t bytes, size_t alignment );
+
+        /// Give back a buffer returned by allocate, with the same size and the same alignment
+        static void deallocate( void* memory, size_t bytes, size_t alignment ) noexcept;
+
+        /// Change the maximal size of the buffers kept in the pool, the surplus is freed
+        /// \note A capacity of 0 disables the pool, each buffer is freed directly
+        static void setCapacity( size_t bytes );
+
+        /// Enable or disable the use of the huge pages, for the next allocated buffers
+        static void setHugePages( bool enabled );
+
+        /// Free all the buffers kept in the pool
+        static void trim();
+
+        static Statistics statistics();
+    };
+
+    /// Tag given to AlignedAllocator::construct, the built pixel is left uninitialized
+    struct Uninitialized {};
+
+    /// Iterator on a range of tags Uninitialized, given to the range constructor of a vector of pixels
+    /// So the pixels are left uninitialized only by the callers who ask for it, with uninitializedBuffer
+    class UninitializedIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Uninitialized;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Uninitialized*;
+        using reference = Uninitialized;
+
+        explicit UninitializedIterator( const size_t position = 0 ) noexcept : position_( position ) {}
+
+        Uninitialized operator*() const noexcept { return {}; }
+
+        UninitializedIterator& operator++() noexcept {
+            ++position_;
+            return *this;
+        }
+
+        UninitializedIterator operator++( int ) noexcept { return UninitializedIterator( position_++ ); }
+
+        UninitializedIterator& operator--() noexcept {
+            --position_;
+            return *this;
+        }
+
+        UninitializedIterator operator--( int ) noexcept { return UninitializedIterator( position_-- ); }
+
+        UninitializedIterator& operator+=( const difference_type offset ) noexcept {
+            position_ = static_cast<size_t>(static_cast<difference_type>(position_) + offset);
+            return *this;
+        }
+
+        UninitializedIterator& operator-=( const difference_type offset ) noexcept { return *this += -offset; }
+
+        UninitializedIterator operator+( const difference_type offset ) const noexcept {
+            return UninitializedIterator( *this ) += offset;
+        }
+
+        friend UninitializedIterator operator+( const difference_type offset,
+                                                const UninitializedIterator& iterator ) noexcept {
+            return iterator + offset;
+        }
+
+        UninitializedIterator operator-( const difference_type offset ) const noexcept {
+            return UninitializedIterator( *this ) -= offset;
+        }
+
+        difference_type operator-( const UninitializedIterator& other ) const noexcept {
+            return static_cast<difference_type>(position_ - other.position_);
+        }
+
+        Uninitialized operator[]( const difference_type ) const noexcept { return {}; }
+
+        bool operator==( const UninitializedIterator& other ) const noexcept { return position_ == other.position_; }
+
+        bool operator!=( const UninitializedIterator& other ) const noexcept { return position_ != other.position_; }
+
+        bool operator<( const UninitializedIterator& other ) const noexcept { return position_ < other.position_; }
+
+        bool operator>( const UninitializedIterator& other ) const noexcept { return other < *this; }
+
+        bool operator<=( const UninitializedIterator& other ) const noexcept { return !( other < *this ); }
+
+        bool operator>=( const UninitializedIterator& other ) const noexcept { return !( *this < other ); }
+
+    private:
+        size_t position_;
+    };
+
+    /// Allocator of memory aligned on Alignment bytes, for the pixels of the images
+    /// The big buffers are taken in the BufferPool, and given back to it
+    template <typename T, size_t Alignment = rowAlignment>
+    class AlignedAllocator {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator( const AlignedAllocator<U, Alignment>& ) noexcept {}
+
+        /// \exception std::bad_alloc if the memory allocation fails
+        T* allocate( const size_t count ) {
+            if ( std::numeric_limits<size_t>::max() / sizeof( T ) < count ) {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<T*>(BufferPool::allocate( count * sizeof( T ), Alignment ));
+        }
+
+        void deallocate( T* const memory, const size_t count ) noexcept {
+            BufferPool::deallocate( memory, count * sizeof( T ), Alignment );
+        }
+
+        /// A pixel built with the tag Uninitialized is left uninitialized, even its default member initializers
+        /// So a buffer of n pixels costs no write, the reader or the scaler who builds it writes each pixel only once
+        /// \warning A buffer reused from the pool still holds the pixels of its previous image
+        /// \note The memory of posix_memalign implicitly holds these trivial pixels
+        template <typename U>
+        void construct( U*, Uninitialized ) noexcept {
+            static_assert( std::is_trivially_copyable<U>::value && std::is_trivially_destructible<U>::value,
+                           "Only the trivial pixels can be left uninitialized" );
+        }
+
+        /// A pixel built without value is value-initialized, like with std::allocator
+        template <typename U, typename... TArgs>
+        void construct( U* const pixel, TArgs&&... args ) {
+            ::new( static_cast<void*>(pixel) ) U( std::forward<TArgs>( args )... );
+        }
+
+        template <typename U>
+        bool operator==( const AlignedAllocator<U, Alignment>& ) const noexcept { return true; }
+
+        template <typename U>
+        bool operator!=( const AlignedAllocator<U, Alignment>& ) const noexcept { return false; }
+    };
+
+    /// \returns A buffer of count pixels left uninitialized, for the callers who write each pixel before reading it
+    /// \exception std::bad_alloc if the memory allocation fails
+    template <typename T>
+    std::vector<T, AlignedAllocator<T>> uninitializedBuffer( const size_t count ) {
+        return std::vector<T, AlignedAllocator<T>>( UninitializedIterator( 0 ), UninitializedIterator( count ) );
+    }
+
+    /// Give count pixels to the given buffer for a new image, its memory is reused if its capacity is large enough
+    /// Otherwise it is replaced by a buffer left uninitialized, the previous pixels are not copied
+    /// \warning The pixels are unspecified, the caller needs to write each of them
+    /// \exception std::bad_alloc if the memory allocation fails
+    template <typename T>
+    void reshapeBuffer( std::vector<T, AlignedAllocator<T>>& buffer, const size_t count ) {
+        if ( buffer.capacity() < count ) {
+            buffer = uninitializedBuffer<T>( count );
+        }
+        else {
+            buffer.resize( count );
+        }
+    }
+
+    /// \returns The smallest stride, greater or equal than width, where each row of pixels of type T starts
+    /// on rowAlignment bytes, when the first row is aligned
+    template <typename T>
+    constexpr size_t alignedStride( const size_t width ) {
+        // Le plus petit nombre de pixels dont la taille est un multiple de l'alignement
+        size_t unit = 1;
+        while ( 0 != ( ( unit * sizeof( T ) ) % rowAlignment ) ) {
+            ++unit;
+        }
+
+        return ( ( width + unit - 1 ) / unit ) * unit;
+    }
+
+    /// Buffer of pixels shared by the copies of an image, with copy on write
+    /// A copy only shares the buffer, the first call who can modify the pixels detaches a private copy of them
+    /// \note The reference counter is atomic, so the copies can be given to several threads
+    /// \warning A pointer or a reference given by a modifying call is on the buffer shared by the later copies,
+    /// the pixels must not be modified through it after a copy
+    template <typename T>
+    class SharedBuffer {
+    public:
+        using Buffer = std::vector<T, AlignedAllocator<T>>;
+
+        /// Share the empty buffer, without memory allocation
+        SharedBuffer() noexcept : block_( &empty() ) {
+            acquire();
+        }
+
+        /// Take the given buffer, without copying its pixels
+        /// \exception std::bad_alloc if the memory allocation fails
+        explicit SharedBuffer( Buffer&& buffer ) : block_( new Block( std::move( buffer ) ) ) {}
+
+        /// Share the buffer of the given one
+        SharedBuffer( const SharedBuffer& src ) noexcept : block_( src.block_ ) {
+            acquire();
+        }
+
+        /// Take the buffer of the given one, who shares the empty buffer
+        SharedBuffer( SharedBuffer&& src ) noexcept : SharedBuffer() {
+            swap( src );
+        }
+
+        ~SharedBuffer() noexcept {
+            release();
+        }
+
+        SharedBuffer& operator=( const SharedBuffer& src ) noexcept {
+            SharedBuffer( src ).swap( *this );
+            return *this;
+        }
+
+        SharedBuffer& operator=( SharedBuffer&& src ) noexcept {
+            swap( src );
+            return *this;
+        }
+
+        /// Take the given buffer, the previous one is released
+        /// \exception std::bad_alloc if the memory allocation fails
+        SharedBuffer& operator=( Buffer&& buffer ) {
+            SharedBuffer( std::move( buffer ) ).swap( *this );
+            return *this;
+        }
+
+        void swap( SharedBuffer& other ) noexcept {
+            std::swap( block_, other.block_ );
+        }
+
+        /// \return true if the buffer is shared with another one
+        bool shared() const noexcept {
+            // acquire : les lectures faites par les copies détruites précèdent les écritures qui suivent
+            return 1 != block_->references.load( std::memory_order_acquire );
+        }
+
+        size_t size() const noexcept { return block_->buffer.size(); }
+
+        /// \return The number of pixels that can be held without memory allocation, 0 if the buffer is shared
+        size_t capacity() const noexcept { return shared() ? 0 : block_->buffer.capacity(); }
+
+        const T* data() const noexcept { return block_->buffer.data(); }
+
+        /// \exception std::bad_alloc if the buffer is shared and the memory allocation fails
+        T* data() {
+            detach( size() );
+            return block_->buffer.data();
+        }
+
+        const T& operator[]( const size_t index ) const noexcept { return block_->buffer[index]; }
+
+        /// \exception std::bad_alloc if the buffer is shared and the memory allocation fails
+        T& operator[]( const size_t index ) {
+            detach( size() );
+            return block_->buffer[index];
+        }
+
+        /// \exception std::out_of_range if the given index is outside [0; size[
+        const T& at( const size_t index ) const { return block_->buffer.at( index ); }
+
+        /// \exception std::out_of_range if the given index is outside [0; size[
+        /// \exception std::bad_alloc if the buffer is shared and the memory allocation fails
+        T& at( const size_t index ) {
+            detach( size() );
+            return block_->buffer.at( index );
+        }
+
+        /// \exception std::bad_alloc if the memory allocation fails
+        void resize( const size_t count ) {
+            detach( std::min( count, size() ) );
+            block_->buffer.resize( count );
+        }
+
+        /// \exception std::bad_alloc if the memory allocation fails
+        void resize( const size_t count, const T& value ) {
+            detach( std::min( count, size() ) );
+            block_->buffer.resize( count, value );
+        }
+
+        /// Give count pixels to the buffer for a new image, like reshapeBuffer of a vector
+        /// A shared buffer is replaced, without copying its pixels
+        /// \exception std::bad_alloc if the memory allocation fails
+        void reshape( const size_t count ) {
+            if ( shared() ) {
+                *this = uninitializedBuffer<T>( count );
+            }
+            else {
+                imageUtils::reshapeBuffer( block_->buffer, count );
+            }
+        }
+
+    private:
+        struct Block {
+            explicit Block( Buffer&& pixels ) noexcept : buffer( std::move( pixels ) ) {}
+
+            Buffer buffer;
+            std::atomic<size_t> references{ 1 };
+        };
+
+        /// The empty buffer, never freed, it keeps one reference on itself so it is always shared
+        static Block& empty() noexcept {
+            static Block* const block = new Block( Buffer() );
+            return *block;
+        }
+
+        void acquire() noexcept {
+            block_->references.fetch_add( 1, std::memory_order_relaxed );
+        }
+
+        void release() noexcept {
+            if ( 1 == block_->references.fetch_sub( 1, std::memory_order_acq_rel ) ) {
+                delete block_;
+            }
+        }
+
+        /// Give a private copy of the count first pixels, if the buffer is shared
+        /// \exception std::bad_alloc if the memory allocation fails
+        void detach( const size_t count ) {
+            if ( shared() ) {
+                // Seuls les pixels conservés sont recopiés, la place des suivants est déjà réservée
+                Buffer buffer;
+                buffer.reserve( size() );
+                buffer.assign( block_->buffer.begin(), block_->buffer.begin() + static_cast<std::ptrdiff_t>(count) );
+
+                *this = std::move( buffer );
+            }
+        }
+
+        Block* block_;
+    };
+
+    /// Give count pixels to the given shared buffer for a new image, like reshapeBuffer of a vector
+    /// \exception std::bad_alloc if the memory allocation fails
+    template <typename T>
+    void reshapeBuffer( SharedBuffer<T>& buffer, const size_t count ) {
+        buffer.reshape( count );
+    }
+
+    /// Storage of the pixels of the images, shared by their copies with the option IMAGE_SHARED_PIXELS
+    template <typename T>
+#ifdef IMAGE_SHARED_PIXELS
+    using PixelBuffer = SharedBuffer<T>;
+#else
+    using PixelBuffer = std::vector<T, AlignedAllocator<T>>;
+#endif
+
+    /// Sample and number of samples of a type of pixel, the intensity of an image is a sample
+    /// A gray pixel is its own sample
+    template <typename TPixel>
+    struct PixelTraits {
+        static_assert( std::is_unsigned<TPixel>::value, "A gray pixel needs to be an unsigned integer" );
+
+        using Sample = TPixel;
+        static constexpr size_t channels = 1;
+    };
+
+    /// Non-owning view on a rectangle of pixels, row after row, where each row holds stride pixels
+    /// A view of const pixels can only read them, a view of pixels can also modify them
+    /// \warning The view does not own the pixels, it is invalid after the destruction of the image who owns them
+    template <typename TPixel>
+    class ImageView {
+    public:
+        /// Type of the intensity of the image who owns the pixels
+        using Sample = typename PixelTraits<std::remove_const_t<TPixel>>::Sample;
+
+        ImageView() = delete;
+
+        /// Build a view on the given pixels, with the given width, height, stride and intensity
+        /// \pre data points on height rows of stride pixels
+        /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+        /// \exception invalidHeight if the given height is outside ]0; maxHeight]
+        /// \exception invalidLength if the given stride is less than the width
+        ImageView( TPixel* data, intmax_t width, intmax_t height, size_t stride, Sample intensity );
+
+        /// A view of pixels is also a view of const pixels
+        template <typename TOther, typename = std::enable_if_t<std::is_same<const TOther, TPixel>::value>>
+        ImageView( const ImageView<TOther>& view ) noexcept
+                : data_( view.row( 0 ) ), width_( view.width() ), height_( view.height() ), stride_( view.stride() ),
+                  intensity_( view.intensity() ) {}
+
+        ImageView( const ImageView& ) noexcept = default;
+        ImageView& operator=( const ImageView& ) noexcept = default;
+
+        ~ImageView() noexcept = default;
+
+        Width width() const noexcept { return width_; }
+        Height height() const noexcept { return height_; }
+
+        /// \return The number of pixels between the start of two rows
+        size_t stride() const noexcept { return stride_; }
+
+        /// \return The intensity of the image who owns the pixels
+        Sample intensity() const noexcept { return intensity_; }
+
+        /// \return The first pixel of the row y
+        /// \warning y is not verified
+        TPixel* row( const size_t y ) const noexcept { return data_ + ( y * stride_ ); }
+
+        /// \return A reference of the pixel at (x,y)
+        /// \exception invalidCoordinateX if x is outside [0; width[
+        /// \exception invalidCoordinateY if y is outside [0; height[
+        TPixel& pixel( intmax_t x, intmax_t y ) const;
+
+        /// Call f( first, last ) on each row, from the top, where [first; last[ are the width pixels of the row
+        /// \note The pixels of a row are contiguous, first and last can be given to the algorithms of the STL
+        template <typename TFunction>
+        void forEachRow( TFunction f ) const {
+            for ( size_t y = 0; y < height_; ++y ) {
+                f( row( y ), row( y ) + width_ );
+            }
+        }
+
+        /// Call f( pixel ) on each pixel, row after row, without verifying their position
+        template <typename TFunction>
+        void forEachPixel( TFunction f ) const {
+            for ( size_t y = 0; y < height_; ++y ) {
+                const auto first = row( y );
+                for ( auto pixel = first; pixel != ( first + width_ ); ++pixel ) {
+                    f( *pixel );
+                }
+            }
+        }
+
+        /// \return A view on the rectangle of this view who starts at start, with the given dimension
+        /// \exception invalidCoordinateX if start.x is outside [0; width[
+        /// \exception invalidCoordinateY if start.y is outside [0; height[
+        /// \exception invalidWidth if the width of dim is outside ]0; width - start.x]
+        /// \exception invalidHeight if the height of dim is outside ]0; height - start.y]
+        ImageView region( Point start, Dimension<> dim ) const;
+
+    private:
+        TPixel* data_;
+        Width width_;
+        Height height_;
+        size_t stride_;
+        Sample intensity_;
+    };
 }
 
 namespace Format {
@@ -74,7 +588,8 @@ namespace Format {
     /// More information :
     /// \note This list don't contain all TARGA formats, it can be modified in the future
     /// \warning Only these formats can be written : UNCOMPRESSED_TRUE_COLOR(24bits), RLE_TRUE_COLOR(24bits)
-    /// \warning Only these formats can be read : UNCOMPRESSED_TRUE_COLOR(24bits), UNCOMPRESSED_COLOR_MAP(24bits)
+    /// \warning Only these formats can be read : UNCOMPRESSED_TRUE_COLOR(24bits), UNCOMPRESSED_COLOR_MAP(24bits),
+    /// UNCOMPRESSED_BLACK_WHITE(8bits), RLE_TRUE_COLOR(24bits), RLE_COLOR_MAP(24bits), RLE_BLACK_WHITE(8bits)
     enum class TARGA {
         NO_IMAGE = 0,
         UNCOMPRESSED_COLOR_MAP = 1,
@@ -91,11 +606,17 @@ namespace Format {
 
 // TODO Mettre à jour les exceptions
 /// Can create or build a gray Image in 2D format, where the intensity or depth is coded on one byte
-/// \warning The maximum of : width = max of uint16_t and height = max of uint16_t
+/// \warning The maximum of : width = max of Width and height = max of Height
 /// \warning The maximum of : intensity = max of uint8_t
 /// \warning GrayImage can only be read or write in PGM
 class GrayImage {
 public:
+    /// Non-owning view on the shades of a gray image, or on a rectangle of them
+    using View = imageUtils::ImageView<Shade>;
+
+    /// Non-owning view who can only read the shades of a gray image
+    using ConstView = imageUtils::ImageView<const Shade>;
+
     /// \warning Can't build a grayImage without giving width and height
     GrayImage() = delete;
 
@@ -153,9 +674,23 @@ public:
     /// \exception std::bad_alloc if the memory allocation fails
     explicit GrayImage( imageUtils::Dimension<> dim, intmax_t intensity );
 
+    /// Build a grayImage with the given Dimension(width, height) and intensity, where each row holds stride shades
+    /// The shades after the width of a row are a padding, uninitialized and never read by the methods of the image
+    /// The first row is aligned on rowAlignment bytes, use imageUtils::alignedStride<Shade>( width ) to align all the rows
+    /// The built image was colored with the default Color
+    /// \pre The given stride needs to be greater or equal than the width
+    /// \post stride() was equal to the given stride
+    /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+    /// \exception invalidHeight if the given height is outside ]0;maxHeight]
+    /// \exception invalidIntensity if the given intensity is outside [0;maxShades]
+    /// \exception invalidLength if the given stride is less than the width
+    /// \exception std::bad_alloc if the memory allocation fails
+    GrayImage( imageUtils::Dimension<> dim, intmax_t intensity, size_t stride );
+
     /// Build a grayImage by copying the given image
     /// \pre The given image needs to be good built
     /// \post The built image was same of the given image
+    /// \note With IMAGE_SHARED_PIXELS, the pixels are shared until the first modification of one of the images
     /// \exception bad_alloc if the memory allocation fails
     GrayImage( const GrayImage& src ) = default;
 
@@ -168,11 +703,14 @@ public:
     ~GrayImage() noexcept = default;
 
 
-    /// \warning Can't affect another image to a built image
-    GrayImage& operator=( const GrayImage& ) = delete;
+    /// Copy the given image in the called image
+    /// \note The buffer of the called image is reused, if its capacity is large enough
+    /// \note With IMAGE_SHARED_PIXELS, the pixels are shared until the first modification of one of the images
+    /// \exception bad_alloc if the memory allocation fails
+    GrayImage& operator=( const GrayImage& src ) = default;
 
-    /// \warning Can't affect another image to a built image
-    GrayImage& operator=( GrayImage&& ) noexcept = delete;
+    /// Move the given image in the called image, the pixels are not copied
+    GrayImage& operator=( GrayImage&& src ) noexcept = default;
 
 
     /// \return A constant reference of the width of Image
@@ -197,6 +735,39 @@ public:
     /// \return A copy of height of Image
     Height height() const noexcept;
 
+    /// \return The number of shades between the start of two rows, equal to the width if the rows have no padding
+    size_t stride() const noexcept;
+
+    /// Change the dimension of the called image, and keep its intensity
+    /// \note The buffer is reused if its capacity is large enough, so a loop on images of the same size allocates nothing
+    /// \note An image with padded rows keeps aligned rows
+    /// \warning The shades are not initialized, they need to be filled or read
+    /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+    /// \exception invalidHeight if the given height is outside ]0; maxHeight]
+    /// \exception std::bad_alloc if the memory allocation fails, the image is not changed
+    void reshape( imageUtils::Dimension<> dim );
+
+    /// Change the dimension and the intensity of the called image, like reshape( dim )
+    /// \exception invalidIntensity if the given intensity is outside ]0; maxIntensity]
+    void reshape( imageUtils::Dimension<> dim, intmax_t intensity );
+
+    /// \return A view on all the shades of the image
+    View view();
+
+    /// \return A view who can only read all the shades of the image
+    ConstView view() const;
+
+    /// \return A view on the rectangle of the image who starts at start, with the given dimension
+    /// \exception invalidCoordinateX if start.x is outside [0; width[
+    /// \exception invalidCoordinateY if start.y is outside [0; height[
+    /// \exception invalidWidth if the width of dim is outside ]0; width - start.x]
+    /// \exception invalidHeight if the height of dim is outside ]0; height - start.y]
+    View view( imageUtils::Point start, imageUtils::Dimension<> dim );
+
+    /// \return A view who can only read the rectangle of the image who starts at start, with the given dimension
+    /// \exception Same as view( Point, Dimension )
+    ConstView view( imageUtils::Point start, imageUtils::Dimension<> dim ) const;
+
 
     /// \return A reference of the pixel at the position x,y
     /// \warning Please don't assign the return reference to a variable with a larger range
@@ -223,6 +794,15 @@ public:
     // [[deprecated ("Please use the method getPixel( pixel )")]]
     const Shade& pixel( intmax_t x, intmax_t y ) const;
 
+    /// \return The first shade of the row y, the width shades of the row are contiguous
+    /// \note Only y is verified, the loops on the shades of a row don't pay a verification by shade
+    /// \exception invalidCoordinateY if y is not in [0; height[
+    Shade* row( intmax_t y );
+
+    /// \return The first shade of the row y, the width shades of the row are contiguous
+    /// \exception invalidCoordinateY if y is not in [0; height[
+    const Shade* row( intmax_t y ) const;
+
     /// Modify the pixel with the given color
     /// \param[in] Pixel( x,y )
     /// \pre Coordinate x of Pixel needs to be in the range of [0; width[
@@ -242,6 +822,44 @@ public:
     /// \exception invalidPosition if y is not int [0; height[
     Shade getPixel( imageUtils::Pixel px ) const;
 
+    /// Copy the given count shades in the row start.y, from the column start.x
+    /// The span is verified once, its shades with one pass, then they are copied with one memcpy
+    /// \exception invalidCoordinateX if start.x is not in [0; width[
+    /// \exception invalidCoordinateY if start.y is not in [0; height[
+    /// \exception invalidLength if count is not in [0; width - start.x]
+    /// \exception invalidShade if a shade is above the intensity, the image is not changed
+    void setRow( imageUtils::Point start, const Shade* shades, intmax_t count );
+
+    /// Copy shades in the given view, like setRow( start, shades, count ) in an image
+    /// \exception Same as setRow( start, shades, count ), with the dimension of the view
+    static void setRow( View view, imageUtils::Point start, const Shade* shades, intmax_t count );
+
+    /// Copy count shades of the row start.y, from the column start.x, in the given array
+    /// \exception invalidCoordinateX if start.x is not in [0; width[
+    /// \exception invalidCoordinateY if start.y is not in [0; height[
+    /// \exception invalidLength if count is not in [0; width - start.x]
+    void getRow( imageUtils::Point start, Shade* shades, intmax_t count ) const;
+
+    /// Copy shades of the given view, like getRow( start, shades, count ) of an image
+    /// \exception Same as getRow( start, shades, count ), with the dimension of the view
+    static void getRow( ConstView view, imageUtils::Point start, Shade* shades, intmax_t count );
+
+    /// Copy the given buffer in the rectangle of the image at start, with the given dimension
+    /// The buffer holds dim.height rows, each row starts stride shades after the start of the previous one
+    /// \note Each row is copied with one memcpy, an external decoded frame is copied with one call
+    /// \exception invalidCoordinateX if start.x is not in [0; width[
+    /// \exception invalidCoordinateY if start.y is not in [0; height[
+    /// \exception invalidWidth if dim.width is not in ]0; width - start.x]
+    /// \exception invalidHeight if dim.height is not in ]0; height - start.y]
+    /// \exception invalidLength if the given stride is less than dim.width
+    /// \exception invalidShade if a shade is above the intensity, the image is not changed
+    void copyRect( const Shade* source, size_t stride, imageUtils::Point start, imageUtils::Dimension<> dim );
+
+    /// Copy the given buffer in the given view, like copyRect( source, stride, start, dim ) in an image
+    /// \exception Same as copyRect( source, stride, start, dim ), with the dimension of the view
+    static void copyRect( View view, const Shade* source, size_t stride, imageUtils::Point start,
+                          imageUtils::Dimension<> dim );
+
 
     /// Clear the image, so the image was fill by the default Color
     void clear();
@@ -258,6 +876,10 @@ public:
     /// \post The same image but fill with the given color
     void fill( intmax_t color );
 
+    /// Fill all the shades of the given view with the given color
+    /// \exception invalidShade if the given color is outside [0; intensity of the view]
+    static void fill( View view, intmax_t color );
+
 
     /// Draw a rectangle with the given width, height and with it top left corner at the position x,y
     /// The drawn rectangle has a thickness of 1 pixel and the default Color
@@ -393,6 +1015,12 @@ public:
     void drawRectangle( imageUtils::Point start, imageUtils::Dimension<> rectangleDim,
                         intmax_t color, imageUtils::FILL filled );
 
+    /// Draw a rectangle in the given view, like drawRectangle( Point, Dimension, color, FILL ) in an image
+    /// The coordinates and the dimension of the rectangle are relative to the view
+    /// \exception Same as drawRectangle( Point, Dimension, color, FILL ), with the dimension of the view
+    static void drawRectangle( View view, imageUtils::Point start, imageUtils::Dimension<> rectangleDim,
+                               intmax_t color, imageUtils::FILL filled );
+
 
     /// Draw a 1 pixel of thickness line, in default Color, with the given length, and it left point at the given position x,y
     /// \pre x needs to be in [0, image's width[
@@ -420,6 +1048,11 @@ public:
     /// \exception imageUtils::invalidEnumTYPE if the type is different from TYPE::HORIZONTAL or TYPE::VERTICAL
     void drawLine( imageUtils::Point start, intmax_t length, intmax_t color, imageUtils::TYPE type );
 
+    /// Draw a line in the given view, like drawLine( Point, length, color, TYPE ) in an image
+    /// The coordinates and the length of the line are relative to the view
+    /// \exception Same as drawLine( Point, length, color, TYPE ), with the dimension of the view
+    static void drawLine( View view, imageUtils::Point start, intmax_t length, intmax_t color, imageUtils::TYPE type );
+
 
     /// Created the same image of called image, but scale to newWidth and newHeight, with the algorithm of simple scale
     /// \warning You have the responsibility of the created image
@@ -442,6 +1075,11 @@ public:
     /// \exception std::bad_alloc if the new image is too large to store
     std::unique_ptr<GrayImage> simpleScale( imageUtils::Dimension<> newDim ) const;
 
+    /// Created an image of the given view, scale to Dimension(newWidth,newHeight), with the algorithm of simple scale
+    /// \note The rows of the created image are aligned, if the rows of the view have a padding
+    /// \exception Same as simpleScale( Dimension )
+    static std::unique_ptr<GrayImage> simpleScale( ConstView view, imageUtils::Dimension<> newDim );
+
 
     /// Created the same image of called image, but scale to newWidth and newHeight, with the algorithm of bilinear scale
     /// \warning You have the responsibility of the created image
@@ -464,6 +1102,11 @@ public:
     /// \exception std::bad_alloc if the new image is too large to store
     std::unique_ptr<GrayImage> bilinearScale( imageUtils::Dimension<> newDim ) const;
 
+    /// Created an image of the given view, scale to Dimension(newWidth,newHeight), with the algorithm of bilinear scale
+    /// \note The rows of the created image are aligned, if the rows of the view have a padding
+    /// \exception Same as bilinearScale( Dimension )
+    static std::unique_ptr<GrayImage> bilinearScale( ConstView view, imageUtils::Dimension<> newDim );
+
 
     // TODO MAJ DESC
     /// Write in the given output stream the called image in the P5 format
@@ -485,6 +1128,10 @@ public:
     /// \post The called image was output in the given the stream
     void writePGM( std::ostream& os, Format::WRITE_IN f ) const;
 
+    /// Write in the given output stream the shades of the given view, like an image, in the given format {ASCII or BINARY}
+    /// \exception invalidFormat if the given format is not ASCII or BINARY
+    static void writePGM( ConstView view, std::ostream& os, Format::WRITE_IN f );
+
     // TODO MAJ DESC
     /// Read the given input stream and create a gray Image
     /// \note Check the representation of Px format : https://en.wikipedia.org/wiki/Netpbm
@@ -536,12 +1183,87 @@ public:
     /// \exception invalidSizeRepresentationPixel if the END OF STREAM was encountered before the reach width * height pixels
     static std::unique_ptr<GrayImage> readPGM_secured( std::istream& is );
 
+    /// Read the given input stream in the given image, like readPGM_secured, the image is reshaped to the read dimension
+    /// \note The buffer of the image is reused if its capacity is large enough
+    /// \warning If an exception is thrown after the header, the shades of the image are unspecified
+    /// \exception Same as readPGM_secured( is )
+    static void readPGM( std::istream& is, GrayImage& image );
+
+    /// Read the file at the given path and create a gray Image
+    /// The file is mapped in memory, the header is parsed in the mapping, and the pixels are copied only once
+    /// \note Check the representation of Px format : https://en.wikipedia.org/wiki/Netpbm
+    /// \note All comments are skipped
+    /// \returns Return a unique_ptr to the created GrayImage
+    /// \pre The given file needs to respect the Px format and this case the P2 or P5
+    /// \post An image sized to width on height, with depth equals to intensity, and pixels equals to value of pixels in the file
+    /// \exception std::runtime_error if the file can't be opened or mapped in memory
+    /// \exception invalidType if the type of format don't match with "P2" or "P5"
+    /// \exception invalidWidth if the width in the file was not in [0, maxWidth]
+    /// \exception invalidHeight if the height in the file was not in ]0; maxHeight]
+    /// \exception invalidIntensity if the intensity in the file was not in [0, maxIntensity]
+    /// \exception invalidPixels if any of read pixels is not in the range of [0, intensity]
+    /// \exception invalidSizeRepresentationPixel if the END OF FILE was encountered before the reach width * height pixels
+    /// \exception alwaysData if the file always contains data after the pixels
+    static std::unique_ptr<GrayImage> readPGM_secured( const char* input );
+
+    /// Write in the given file the called image in the format JPEG, with only one component of gray, and the default quality
+    /// \note If the intensity is not 255, the shades are scaled to [0, 255]
+    /// \post The called image was output in the given file
+    /// \exception std::runtime_error if the file can't be opened
+    void writeJPEG( const char* output ) const;
+
+    /// Write in the given file the called image in the format JPEG, with only one component of gray, and the given quality
+    /// \note If the intensity is not 255, the shades are scaled to [0, 255]
+    /// \pre The quality needs to be in [0; 100]
+    /// \post The called image was output in the given file
+    /// \exception std::runtime_error if the file can't be opened
+    /// \exception invalidJPEG if the JPEG library reports an error
+    void writeJPEG( const char* output, int quality ) const;
+
+    /// Write in the given output stream the called image in the format JPEG, with only one component of gray, and the default quality
+    /// \pre A good output stream
+    /// \post The called image was output in the given the stream
+    void writeJPEG( std::ostream& os ) const;
+
+    /// Write in the given output stream the called image in the format JPEG, with only one component of gray, and the given quality
+    /// \pre A good output stream
+    /// \pre The quality needs to be in [0; 100]
+    /// \post The called image was output in the given the stream
+    /// \exception invalidJPEG if the JPEG library reports an error
+    void writeJPEG( std::ostream& os, int quality ) const;
+
+    /// Write in the given output stream the shades of the given view, like an image, in the format JPEG with the given quality
+    /// \pre The quality needs to be in [0; 100]
+    static void writeJPEG( ConstView view, std::ostream& os, int quality );
+
+    /// Read the given JPEG file and create a gray Image, the JPEG library decompresses only the gray component
+    /// \note A color JPEG is converted in gray by the JPEG library
+    /// \returns Return a unique_ptr to the created GrayImage, its intensity is 255
+    /// \pre The given file needs to respect the JPEG format
+    /// \exception std::runtime_error if the file can't be opened
+    /// \exception std::bad_alloc if the memory allocation failed
+    /// \exception invalidJPEG if the JPEG library reports an error, like corrupt data
+    static std::unique_ptr<GrayImage> readJPEG( const char* input );
+
+    /// Read the given input stream and create a gray Image, the JPEG library decompresses only the gray component
+    /// \note A color JPEG is converted in gray by the JPEG library
+    /// \warning The input stream is read by big blocks, so data after the end of the JPEG image can be consumed
+    /// \returns Return a unique_ptr to the created GrayImage, its intensity is 255
+    /// \pre The given stream needs to respect the JPEG format
+    /// \exception std::bad_alloc if the memory allocation failed
+    /// \exception invalidJPEG if the JPEG library reports an error, like corrupt data
+    static std::unique_ptr<GrayImage> readJPEG( std::istream& is );
+
 
 private:
-    const imageUtils::Dimension<Width, Height> dimension;
-    const Shade intensity_{ defaultIntensity };
+    /// The shades of the image, row after row, each row holds stride_ shades
+    using Pixels = std::vector<Shade, imageUtils::AlignedAllocator<Shade>>;
 
-    std::vector<Shade> pixels_;
+    imageUtils::Dimension<Width, Height> dimension;
+    Shade intensity_{ defaultIntensity };
+    size_t stride_;
+
+    imageUtils::PixelBuffer<Shade> pixels_;
 
 
     /// The color black in shade of gray
@@ -553,6 +1275,9 @@ private:
     /// The default intensity
     static const Shade defaultIntensity;
 
+    /// Default quality for JPEG
+    static constexpr auto defaultJPEGQuality = 75;
+
     /// Build a gray Image with the given width and height, intensity and the vector of shades
     /// \warning This builder move the given vector
     /// \pre The given width needs to be greater than 0 and less or equal than maximum width
@@ -570,7 +1295,14 @@ private:
     /// \exception invalidSizeArray if the given vector don't have the good size like vector_size == width * height
     /// \exception badValuePixel if a pixel in the given vector, have a value above the intensity
     /// \exception std::bad_alloc if the memory allocation fails
-    explicit GrayImage( imageUtils::Dimension<> dim, intmax_t intensity, std::vector<Shade>&& pixels );
+    explicit GrayImage( imageUtils::Dimension<> dim, intmax_t intensity, Pixels&& pixels );
+
+    /// Build a gray Image like GrayImage( Dimension, intensity, Pixels&& ), where each row of the vector holds stride shades
+    /// \pre The given vector of shades needs to have it size equal to stride * height
+    /// \note With VERIFIED::YES, the shades come from the library and are not verified
+    /// \exception invalidLength if the given stride is less than the width
+    GrayImage( imageUtils::Dimension<> dim, intmax_t intensity, size_t stride, Pixels&& pixels,
+               imageUtils::VERIFIED verified = imageUtils::VERIFIED::NO );
 
     /// Build a gray Image with the given Dimension(width,height), intensity and the vector of shades
     /// \warning This builder move the given vector
@@ -590,7 +1322,25 @@ private:
     /// \exception badValuePixel if a pixel in the given vector, have a value above the intensity
     /// \exception std::bad_alloc if the memory allocation fails
     static std::unique_ptr<GrayImage>
-    createGrayImage( imageUtils::Dimension<> dim, intmax_t intensity, std::vector<Shade>&& pixels );
+    createGrayImage( imageUtils::Dimension<> dim, intmax_t intensity, Pixels&& pixels );
+
+    /// Build a gray Image like createGrayImage( Dimension, intensity, Pixels&& ), where each row holds stride shades
+    /// \note With VERIFIED::YES, the shades come from the library and are not verified
+    static std::unique_ptr<GrayImage>
+    createGrayImage( imageUtils::Dimension<> dim, intmax_t intensity, size_t stride, Pixels&& pixels,
+                     imageUtils::VERIFIED verified = imageUtils::VERIFIED::NO );
+
+    /// Read the shades of a PGM image in the given image, already shaped to the header, P5 if binary, P2 otherwise
+    /// \exception invalidShade if a read shade is above the intensity of the image
+    /// \exception invalidSizeRepresentationPixel if the end of stream was reached before reading all shades
+    /// \exception alwaysData if the stream always contains data after the shades
+    static void readPGMShades( std::istream& is, bool binary, GrayImage& image );
+
+    /// Compress the shades of the given view with the given compressor, its destination needs to be set
+    static void compressJPEG( ConstView view, jpeg_compress_struct& cinfo, int quality );
+
+    /// Decompress an image with the given decompressor, its source needs to be set
+    static std::unique_ptr<GrayImage> decompressJPEG( jpeg_decompress_struct& cinfo );
 };
 
 /// This class is for create a rgb color
@@ -618,12 +1368,125 @@ public:
     Shade b_{ 0 };
 };
 
+/// Color where each shade is coded on two bytes, for the images with an intensity above 255
+struct Color16 {
+    uint16_t r_{ 0 };
+    uint16_t g_{ 0 };
+    uint16_t b_{ 0 };
+};
+
+namespace imageUtils {
+    /// A color holds three contiguous samples : red, green, blue
+    template <>
+    struct PixelTraits<Color> {
+        using Sample = Shade;
+        static constexpr size_t channels = 3;
+    };
+
+    template <>
+    struct PixelTraits<Color16> {
+        using Sample = uint16_t;
+        static constexpr size_t channels = 3;
+    };
+}
+
+/// Color image stored in three planes of shades, red, green then blue, instead of interleaved colors
+/// Each plane holds its rows like a GrayImage, so the kernels of one channel work on contiguous shades
+/// \note ColorImage::planes and ColorImage::fromPlanes convert from and to the interleaved colors
+class ColorPlanes {
+public:
+    /// Non-owning view on the shades of one plane
+    using View = imageUtils::ImageView<Shade>;
+
+    /// Non-owning view who can only read the shades of one plane
+    using ConstView = imageUtils::ImageView<const Shade>;
+
+    /// \warning Can't build planes without giving width, height and intensity
+    ColorPlanes() = delete;
+
+    /// Build three black planes with the given width, height and intensity
+    /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+    /// \exception invalidHeight if the given height is outside ]0; maxHeight]
+    /// \exception invalidIntensity if the given intensity is outside ]0; maxIntensity]
+    /// \exception std::bad_alloc if the memory allocation fails
+    ColorPlanes( intmax_t width, intmax_t height, intmax_t intensity );
+
+    ColorPlanes( const ColorPlanes& ) = default;
+    ColorPlanes( ColorPlanes&& ) noexcept = default;
+
+    ~ColorPlanes() noexcept = default;
+
+    ColorPlanes& operator=( const ColorPlanes& ) = default;
+    ColorPlanes& operator=( ColorPlanes&& ) noexcept = default;
+
+    Width width() const noexcept;
+    Height height() const noexcept;
+    Shade intensity() const noexcept;
+
+    /// \return The plane of red, green or blue shades
+    View red();
+    ConstView red() const;
+
+    View green();
+    ConstView green() const;
+
+    View blue();
+    ConstView blue() const;
+
+    /// Created the same planes, scaled to newWidth and newHeight, with the algorithm of bilinear scale of ColorImage
+    /// \warning You have the responsibility of the created planes
+    /// \post Interleaved, the created planes are the image created by ColorImage::bilinearScale
+    /// \exception invalidWidth if newWidth does not in ]0; maxWidth]
+    /// \exception invalidHeight if newHeight does not in ]0; maxHeight]
+    ColorPlanes* bilinearScale( intmax_t newWidth, intmax_t newHeight ) const;
+
+    /// Created the anaglyphe of the called planes, like ColorImage::anaglyphe
+    /// \note The red plane comes from the right half, the green and blue planes from the left half
+    /// \warning You have the responsibility of the created planes
+    ColorPlanes* anaglyphe() const;
+
+    /// Write in the given output stream the planes in the format Maison2, like ColorImage::writeMaison2
+    void writeMaison2( std::ostream& os ) const;
+
+    /// Read the given input stream in the format Maison2, like ColorImage::readMaison2, without interleaving the planes
+    /// \warning You have the responsibility of the created planes
+    /// \exception Same as ColorImage::readMaison2
+    static ColorPlanes* readMaison2( std::istream& is );
+
+private:
+    /// The three planes, one after the other, each one holds width_ * height_ shades
+    using Shades = std::vector<Shade, imageUtils::AlignedAllocator<Shade>>;
+
+    Width width_;
+    Height height_;
+    Shade intensity_;
+
+    Shades shades_;
+
+    /// Build planes with the given shades, the red plane first, then the green and the blue planes
+    /// \pre The shades are in [0; intensity]
+    /// \exception invalidSizeArray if the size of shades is not 3 * width * height
+    ColorPlanes( intmax_t width, intmax_t height, intmax_t intensity, Shades&& shades );
+
+    /// \return The first shade of the plane of the given index, 0 for red, 1 for green and 2 for blue
+    Shade* plane( size_t index ) noexcept;
+    const Shade* plane( size_t index ) const noexcept;
+
+    friend class ColorImage;
+};
+
 
 /// Can create or build a gray Image in 2D format, where the intensity or depth is coded on one byte
-/// \warning The maximum of : width = max of uint16_t and height = max of uint16_t
+/// \warning The maximum of : width = max of Width and height = max of Height
 /// \warning The maximum of : intensity = max of uint8_t
 class ColorImage {
 public:
+    /// Non-owning view on the pixels of a color image, or on a rectangle of them
+    using View = imageUtils::ImageView<Color>;
+
+    /// Non-owning view who can only read the pixels of a color image
+    using ConstView = imageUtils::ImageView<const Color>;
+
     /// \warning Can't build a grayImage without giving width and height
     ColorImage() = delete;
 
@@ -652,9 +1515,23 @@ public:
     /// \exception std::bad_alloc if the memory allocation fails
     ColorImage( intmax_t width, intmax_t height, intmax_t intensity );
 
+    /// Build a colorImage with the given width, height and intensity, where each row holds stride pixels
+    /// The pixels after the width of a row are a padding, uninitialized and never read by the methods of the image
+    /// The first row is aligned on rowAlignment bytes, use imageUtils::alignedStride<Color>( width ) to align all the rows
+    /// The built image was colored with the default Color
+    /// \pre The given stride needs to be greater or equal than the width
+    /// \post stride() was equal to the given stride
+    /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+    /// \exception invalidHeight if the given height is outside ]0;maxHeight]
+    /// \exception invalidIntensity if the given intensity is outside [0;maxShades]
+    /// \exception invalidLength if the given stride is less than the width
+    /// \exception std::bad_alloc if the memory allocation fails
+    ColorImage( intmax_t width, intmax_t height, intmax_t intensity, size_t stride );
+
     /// Build a grayImage by copying the given image
     /// \pre The given image needs to be good built
     /// \post The built image was same of the given image
+    /// \note With IMAGE_SHARED_PIXELS, the pixels are shared until the first modification of one of the images
     /// \exception bad_alloc if the memory allocation fails
     ColorImage( const ColorImage& src ) = default;
 
@@ -667,11 +1544,14 @@ public:
     ~ColorImage() noexcept = default;
 
 
-    /// \warning Can't affect another image to a built image
-    ColorImage& operator=( const ColorImage& ) = delete;
+    /// Copy the given image in the called image
+    /// \note The buffer of the called image is reused, if its capacity is large enough
+    /// \note With IMAGE_SHARED_PIXELS, the pixels are shared until the first modification of one of the images
+    /// \exception bad_alloc if the memory allocation fails
+    ColorImage& operator=( const ColorImage& src ) = default;
 
-    /// \warning Can't affect another image to a built image
-    ColorImage& operator=( ColorImage&& ) noexcept = delete;
+    /// Move the given image in the called image, the pixels are not copied
+    ColorImage& operator=( ColorImage&& src ) noexcept = default;
 
 
     /// \return A constant reference of the width of Image
@@ -680,6 +1560,39 @@ public:
     /// \return A constant reference of the height of Image
     const Height& getHeight() const noexcept;
 
+    /// \return The number of pixels between the start of two rows, equal to the width if the rows have no padding
+    size_t stride() const noexcept;
+
+    /// Change the width and the height of the called image, and keep its intensity
+    /// \note The buffer is reused if its capacity is large enough, so a loop on images of the same size allocates nothing
+    /// \note An image with padded rows keeps aligned rows
+    /// \warning The pixels are not initialized, they need to be filled or read
+    /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+    /// \exception invalidHeight if the given height is outside ]0; maxHeight]
+    /// \exception std::bad_alloc if the memory allocation fails, the image is not changed
+    void reshape( intmax_t width, intmax_t height );
+
+    /// Change the width, the height and the intensity of the called image, like reshape( width, height )
+    /// \exception invalidIntensity if the given intensity is outside ]0; maxIntensity]
+    void reshape( intmax_t width, intmax_t height, intmax_t intensity );
+
+    /// \return A view on all the pixels of the image
+    View view();
+
+    /// \return A view who can only read all the pixels of the image
+    ConstView view() const;
+
+    /// \return A view on the rectangle of the image who starts at start, with the given dimension
+    /// \exception invalidCoordinateX if start.x is outside [0; width[
+    /// \exception invalidCoordinateY if start.y is outside [0; height[
+    /// \exception invalidWidth if the width of dim is outside ]0; width - start.x]
+    /// \exception invalidHeight if the height of dim is outside ]0; height - start.y]
+    View view( imageUtils::Point start, imageUtils::Dimension<> dim );
+
+    /// \return A view who can only read the rectangle of the image who starts at start, with the given dimension
+    /// \exception Same as view( Point, Dimension )
+    ConstView view( imageUtils::Point start, imageUtils::Dimension<> dim ) const;
+
 
     /// \return A reference of the pixel at the position x,y
     /// \param[in] position x,y
@@ -694,6 +1607,53 @@ public:
     /// \exception invalidPosition if y is not int [0; height[
     const Color& pixel( intmax_t x, intmax_t y ) const;
 
+    /// \return The first pixel of the row y, the width pixels of the row are contiguous
+    /// \note Only y is verified, the loops on the pixels of a row don't pay a verification by pixel
+    /// \exception invalidCoordinateY if y is not in [0; height[
+    Color* row( intmax_t y );
+
+    /// \return The first pixel of the row y, the width pixels of the row are contiguous
+    /// \exception invalidCoordinateY if y is not in [0; height[
+    const Color* row( intmax_t y ) const;
+
+    /// Copy the given count pixels in the row start.y, from the column start.x
+    /// The span is verified once, its pixels with one pass, then they are copied with one memcpy
+    /// \exception invalidCoordinateX if start.x is not in [0; width[
+    /// \exception invalidCoordinateY if start.y is not in [0; height[
+    /// \exception invalidLength if count is not in [0; width - start.x]
+    /// \exception invalidShade if a shade is above the intensity, the image is not changed
+    void setRow( imageUtils::Point start, const Color* pixels, intmax_t count );
+
+    /// Copy pixels in the given view, like setRow( start, pixels, count ) in an image
+    /// \exception Same as setRow( start, pixels, count ), with the dimension of the view
+    static void setRow( View view, imageUtils::Point start, const Color* pixels, intmax_t count );
+
+    /// Copy count pixels of the row start.y, from the column start.x, in the given array
+    /// \exception invalidCoordinateX if start.x is not in [0; width[
+    /// \exception invalidCoordinateY if start.y is not in [0; height[
+    /// \exception invalidLength if count is not in [0; width - start.x]
+    void getRow( imageUtils::Point start, Color* pixels, intmax_t count ) const;
+
+    /// Copy pixels of the given view, like getRow( start, pixels, count ) of an image
+    /// \exception Same as getRow( start, pixels, count ), with the dimension of the view
+    static void getRow( ConstView view, imageUtils::Point start, Color* pixels, intmax_t count );
+
+    /// Copy the given buffer in the rectangle of the image at start, with the given dimension
+    /// The buffer holds dim.height rows, each row starts stride pixels after the start of the previous one
+    /// \note Each row is copied with one memcpy, an external decoded frame is copied with one call
+    /// \exception invalidCoordinateX if start.x is not in [0; width[
+    /// \exception invalidCoordinateY if start.y is not in [0; height[
+    /// \exception invalidWidth if dim.width is not in ]0; width - start.x]
+    /// \exception invalidHeight if dim.height is not in ]0; height - start.y]
+    /// \exception invalidLength if the given stride is less than dim.width
+    /// \exception invalidShade if a shade is above the intensity, the image is not changed
+    void copyRect( const Color* source, size_t stride, imageUtils::Point start, imageUtils::Dimension<> dim );
+
+    /// Copy the given buffer in the given view, like copyRect( source, stride, start, dim ) in an image
+    /// \exception Same as copyRect( source, stride, start, dim ), with the dimension of the view
+    static void copyRect( View view, const Color* source, size_t stride, imageUtils::Point start,
+                          imageUtils::Dimension<> dim );
+
 
 
     /// Clear the image, so the image was fill by the default Color
@@ -711,6 +1671,9 @@ public:
     /// \post The same image but fill with the given color
     void fill( Color color );
 
+    /// Fill all the pixels of the given view with the given color
+    static void fill( View view, Color color );
+
 
 
     /// Draw a rectangle with the given width and height and with it top left corner at the position x,y
@@ -741,6 +1704,11 @@ public:
     /// \exception invalidColor if color does not in [0; image's intensity]
     void rectangle( intmax_t x, intmax_t y, intmax_t width, intmax_t height, Color color );
 
+    /// Draw a rectangle in the given view, like rectangle( x, y, width, height, color ) in an image
+    /// The coordinates and the dimension of the rectangle are relative to the view
+    /// \exception Same as rectangle( x, y, width, height, color ), with the dimension of the view
+    static void rectangle( View view, intmax_t x, intmax_t y, intmax_t width, intmax_t height, Color color );
+
     /// Draw a filled rectangle with the given width and height and with it top left corner at the position x,y
     /// The drawn rectangle has a thickness of 1 pixel and the default Color
     /// \pre The given coordinate x needs to be in [0, image's width[
@@ -769,6 +1737,11 @@ public:
     /// \exception invalidColor if color does not in [0; image's intensity]
     void fillRectangle( intmax_t x, intmax_t y, intmax_t width, intmax_t height, Color color );
 
+    /// Draw a filled rectangle in the given view, like fillRectangle( x, y, width, height, color ) in an image
+    /// The coordinates and the dimension of the rectangle are relative to the view
+    /// \exception Same as fillRectangle( x, y, width, height, color ), with the dimension of the view
+    static void fillRectangle( View view, intmax_t x, intmax_t y, intmax_t width, intmax_t height, Color color );
+
 
     /// Draw a 1 pixel of thickness horizontal line, in default Color, with the given length, and it left point at the given position x,y
     /// \pre x needs to be in [0, image's width[
@@ -792,6 +1765,11 @@ public:
     /// \exception invalidColor if color does not in [0, image's intensity]
     void horizontalLine( intmax_t x, intmax_t y, intmax_t length, Color color );
 
+    /// Draw a horizontal line in the given view, like horizontalLine( x, y, length, color ) in an image
+    /// The coordinates and the length of the line are relative to the view
+    /// \exception Same as horizontalLine( x, y, length, color ), with the dimension of the view
+    static void horizontalLine( View view, intmax_t x, intmax_t y, intmax_t length, Color color );
+
     /// Draw a 1 pixel of thickness vertical line, in default Color, with the given length, and its top point at the given position x,y
     /// \pre x needs to be in [0, image's width[
     /// \pre y needs to be in [0; image's height[
@@ -814,6 +1792,11 @@ public:
     /// \exception invalidColor if color does not in [0, image's intensity]
     void verticalLine( intmax_t x, intmax_t y, intmax_t length, Color color );
 
+    /// Draw a vertical line in the given view, like verticalLine( x, y, length, color ) in an image
+    /// The coordinates and the length of the line are relative to the view
+    /// \exception Same as verticalLine( x, y, length, color ), with the dimension of the view
+    static void verticalLine( View view, intmax_t x, intmax_t y, intmax_t length, Color color );
+
 
     /// Created the same image of called image, but scale to newWidth and newHeight, with the algorithm of simple scale
     /// \warning You have the responsibility of the created image
@@ -824,6 +1807,12 @@ public:
     /// \exception invalidHeight if newHeight does not in ]0; maxHeight]
     ColorImage* simpleScale( intmax_t newWidth, intmax_t newHeight ) const;
 
+    /// Created an image of the given view, scale to newWidth and newHeight, with the algorithm of simple scale
+    /// \warning You have the responsibility of the created image
+    /// \note The rows of the created image are aligned, if the rows of the view have a padding
+    /// \exception Same as simpleScale( newWidth, newHeight )
+    static ColorImage* simpleScale( ConstView view, intmax_t newWidth, intmax_t newHeight );
+
     /// Created the same image of called image, but scale to newWidth and newHeight, with the algorithm of bilinear scale
     /// \warning You have the responsibility of the created image
     /// \pre newWidth needs to be in ]0; maxWidth]
@@ -833,6 +1822,12 @@ public:
     /// \exception invalidHeight if newHeight does not in ]0; maxHeight]
     ColorImage* bilinearScale( intmax_t newWidth, intmax_t newHeight ) const;
 
+    /// Created an image of the given view, scale to newWidth and newHeight, with the algorithm of bilinear scale
+    /// \warning You have the responsibility of the created image
+    /// \note The rows of the created image are aligned, if the rows of the view have a padding
+    /// \exception Same as bilinearScale( newWidth, newHeight )
+    static ColorImage* bilinearScale( ConstView view, intmax_t newWidth, intmax_t newHeight );
+
 
 
     /// Write in the given output stream the called image in the P5 format
@@ -853,6 +1848,10 @@ public:
     /// \post The called image was output in the given the stream
     void writePPM( std::ostream& os, Format::WRITE_IN f ) const;
 
+    /// Write in the given output stream the pixels of the given view, like an image, in the given format {ASCII or BINARY}
+    /// \exception invalidFormat if the given format is not ASCII or BINARY
+    static void writePPM( ConstView view, std::ostream& os, Format::WRITE_IN f );
+
     /// Write in the given output stream the called image in the format TARGA
     /// \note Check the representation of TARGA format : URL
     /// \note Or : URL
@@ -876,6 +1875,10 @@ public:
     /// \post The called image was output in the given the stream
     void writeTGA( std::ostream& os, Format::WRITE_IN f ) const;
 
+    /// Write in the given output stream the pixels of the given view, like an image, in the format TARGA
+    /// \exception invalidEnumTYPE if the given format is not RLE or NO_RLE
+    static void writeTGA( ConstView view, std::ostream& os, Format::WRITE_IN f );
+
     /// Write in the given output stream the called image in the format JPEG
     /// \note Check the representation of JPEG format : URL
     /// \note Or : URL
@@ -889,8 +1892,47 @@ public:
     /// \note Or : URL
     /// \pre A good output stream
     /// \post The called image was output in the given the stream
+    /// \exception invalidJPEG if the JPEG library reports an error
     void writeJPEG( const char* output, int quality ) const;
 
+    /// Write in the given output stream the called image in the format JPEG, with the default quality
+    /// The compressed image is written by big blocks in the stream, without temporary file
+    /// \pre A good output stream
+    /// \post The called image was output in the given the stream
+    void writeJPEG( std::ostream& os ) const;
+
+    /// Write in the given output stream the called image in the format JPEG, with the given quality
+    /// The compressed image is written by big blocks in the stream, without temporary file
+    /// \pre A good output stream
+    /// \pre The quality needs to be in [0; 100]
+    /// \post The called image was output in the given the stream
+    /// \exception invalidJPEG if the JPEG library reports an error
+    void writeJPEG( std::ostream& os, int quality ) const;
+
+    /// Write in the given buffer the called image in the format JPEG, with the default quality
+    /// \post The given buffer contains only the compressed image, its size is the size of the compressed image
+    /// \exception std::bad_alloc if the memory allocation fails
+    void writeJPEG( std::vector<uint8_t>& output ) const;
+
+    /// Write in the given buffer the called image in the format JPEG, with the given quality
+    /// \pre The quality needs to be in [0; 100]
+    /// \post The given buffer contains only the compressed image, its size is the size of the compressed image
+    /// \exception std::bad_alloc if the memory allocation fails
+    /// \exception invalidJPEG if the JPEG library reports an error
+    void writeJPEG( std::vector<uint8_t>& output, int quality ) const;
+
+    /// Write in the given output stream the pixels of the given view, like an image, in the format JPEG with the given quality
+    /// \pre The quality needs to be in [0; 100]
+    static void writeJPEG( ConstView view, std::ostream& os, int quality );
+
+    /// Write in the given output stream the called image in the format Maison2, like readMaison2
+    /// \pre A good output stream
+    /// \post The called image was output in the given the stream
+    void writeMaison2( std::ostream& os ) const;
+
+    /// Write in the given output stream the pixels of the given view, like an image, in the format Maison2
+    static void writeMaison2( ConstView view, std::ostream& os );
+
 
     /// Read the given input stream and create a gray Image
     /// \note Check the representation of Px format : https://en.wikipedia.org/wiki/Netpbm
@@ -917,6 +1959,30 @@ public:
     /// \exception invalidSizeRepresentationPixel if the END OF STREAM was encountered before the reach width * height pixels
     static ColorImage* readPPM( std::istream& is );
 
+    /// Read the given input stream in the given image, like readPPM( is ), the image is reshaped to the read dimension
+    /// \note The buffer of the image is reused if its capacity is large enough
+    /// \warning If an exception is thrown after the header, the pixels of the image are unspecified
+    /// \exception Same as readPPM( is )
+    static void readPPM( std::istream& is, ColorImage& image );
+
+    /// Read the file at the given path and create a color Image
+    /// The file is mapped in memory, the header is parsed in the mapping, and the pixels are copied only once
+    /// \note Check the representation of Px format : https://en.wikipedia.org/wiki/Netpbm
+    /// \note All comments are skipped
+    /// \warning You have the responsibility to manage and delete the created image
+    /// \return A raw pointer to the built image
+    /// \pre The given file needs to respect the Px format and this case the P3 or P6
+    /// \post An image sized to width on height, with depth equals to intensity, and pixels equals to value of pixels in the file
+    /// \exception std::runtime_error if the file can't be opened or mapped in memory
+    /// \exception invalidType if the type of format don't match with "P3" or "P6"
+    /// \exception invalidWidth if the width in the file was not in [0, maxWidth]
+    /// \exception invalidHeight if the height in the file was not in ]0; maxHeight]
+    /// \exception invalidIntensity if the intensity in the file was not in [0, maxIntensity]
+    /// \exception invalidPixels if any of read pixels is not in the range of [0, intensity]
+    /// \exception alwaysData if the file always contains data after the pixels
+    /// \exception invalidSizeRepresentationPixel if the END OF FILE was encountered before the reach width * height pixels
+    static ColorImage* readPPM( const char* input );
+
     /// Read the given input stream and create a gray Image
     /// \note Check the representation of TARGA format : URL
     /// \note Or : URL
@@ -940,6 +2006,12 @@ public:
     /// \exception invalidSizeRepresentationPixel if the END OF STREAM was encountered before the reach width * height pixels
     static ColorImage* readTGA( std::istream& is );
 
+    /// Read the given input stream in the given image, like readTGA( is ), the image is reshaped to the read dimension
+    /// \note The buffer of the image is reused if its capacity is large enough
+    /// \warning If an exception is thrown after the header, the pixels of the image are unspecified
+    /// \exception Same as readTGA( is )
+    static void readTGA( std::istream& is, ColorImage& image );
+
     /// Read the given input stream and create a gray Image
     /// \note Check the representation of JPEG format : URL
     /// \note Or : URL
@@ -961,11 +2033,57 @@ public:
     /// \exception std::bad_alloc if the memory allocation failed
     /// \exception alwaysData if the stream always contains data
     /// \exception invalidSizeRepresentationPixel if the END OF STREAM was encountered before the reach width * height pixels
+    /// \exception invalidJPEG if the JPEG library reports an error, like corrupt data
     static ColorImage* readJPEG( const char* input );
 
+    /// Read the given input stream and create a color Image, without temporary file
+    /// \warning You have the responsibility to manage and delete the created image
+    /// \warning The input stream is read by big blocks, so data after the end of the JPEG image can be consumed
+    /// \return A raw pointer to the built image
+    /// \pre The given stream needs to respect the JPEG format
+    /// \exception std::bad_alloc if the memory allocation failed
+    /// \exception invalidJPEG if the JPEG library reports an error, like corrupt data
+    static ColorImage* readJPEG( std::istream& is );
+
+    /// Read the given buffer of size bytes and create a color Image, without temporary file and without copy
+    /// \warning You have the responsibility to manage and delete the created image
+    /// \return A raw pointer to the built image
+    /// \pre The given buffer needs to respect the JPEG format
+    /// \exception std::bad_alloc if the memory allocation failed
+    /// \exception invalidJPEG if the JPEG library reports an error, like corrupt data
+    static ColorImage* readJPEG( const uint8_t* data, size_t size );
+
+    /// Read the given JPEG file and create a color Image sized to newWidth and newHeight
+    /// The image is decoded directly at 1/2, 1/4 or 1/8 of its size by the JPEG library when it is possible,
+    /// only the remaining ratio is done with the bilinear scale
+    /// \warning You have the responsibility to manage and delete the created image
+    /// \return A raw pointer to the built image
+    /// \pre The given file needs to respect the JPEG format
+    /// \pre newWidth needs to be in ]0; maxWidth] and newHeight in ]0; maxHeight], or both equal to 0 to keep the size of the file
+    /// \exception invalidWidth if newWidth does not in ]0; maxWidth]
+    /// \exception invalidHeight if newHeight does not in ]0; maxHeight]
+    /// \exception std::bad_alloc if the memory allocation failed
+    /// \exception invalidJPEG if the JPEG library reports an error, like corrupt data
+    static ColorImage* readJPEG( const char* input, intmax_t newWidth, intmax_t newHeight );
+
+    /// Read the given input stream and create a color Image sized to newWidth and newHeight, like readJPEG( const char*, intmax_t, intmax_t )
+    /// \warning You have the responsibility to manage and delete the created image
+    /// \warning The input stream is read by big blocks, so data after the end of the JPEG image can be consumed
+    static ColorImage* readJPEG( std::istream& is, intmax_t newWidth, intmax_t newHeight );
+
+    /// Read the given buffer of size bytes and create a color Image sized to newWidth and newHeight, like readJPEG( const char*, intmax_t, intmax_t )
+    /// \warning You have the responsibility to manage and delete the created image
+    static ColorImage* readJPEG( const uint8_t* data, size_t size, intmax_t newWidth, intmax_t newHeight );
+
     // TODO Faire une méthode qui retourne un unique ptr
     /// This method create a ColorImage with the format Maison2
+    /// \note The header is "Maison2", the size of the comment on one byte, the height and the width on two bytes,
+    /// \note the most significant byte first, the comment, and the planes of green, blue and red shades
+    /// \note The comment is skipped, each plane is read in one time
     /// \warning You have the responsibility to manage the return pointer
+    /// \exception invalidType if the type of format don't match with "Maison2"
+    /// \exception invalidSizeRepresentationPixel if the END OF STREAM was encountered before the reach of the three planes
+    /// \exception std::bad_alloc if the memory allocation failed
     static ColorImage* readMaison2( std::istream& is );
 
     // TODO REtourner une pointeur safe
@@ -973,17 +2091,38 @@ public:
     /// \warning You have the responsiblity to manage the returned pointer
     ColorImage* anaglyphe() const;
 
+    /// This method create an anaglyphe of the given view
+    /// \warning You have the responsiblity to manage the returned pointer
+    static ColorImage* anaglyphe( ConstView view );
+
+    /// \return The shades of the called image, split in three planes
+    /// \exception std::bad_alloc if the memory allocation fails
+    ColorPlanes planes() const;
+
+    /// \return The shades of the pixels of the given view, split in three planes
+    /// \exception std::bad_alloc if the memory allocation fails
+    static ColorPlanes planes( ConstView view );
+
+    /// Created the image of the interleaved shades of the given planes
+    /// \warning You have the responsibility of the created image
+    /// \exception std::bad_alloc if the memory allocation fails
+    static ColorImage* fromPlanes( const ColorPlanes& planes );
+
     /// Not done
     /// Give two point and one color, and this function draw a right line from point 1 to point 2
     void line( intmax_t x1, intmax_t y1, intmax_t x2, intmax_t y2, Color color );
 
 
 private:
-    const Width width_;
-    const Height height_;
-    const Shade intensity_{ defaultIntensity };
+    /// The pixels of the image, row after row, each row holds stride_ pixels
+    using Pixels = std::vector<Color, imageUtils::AlignedAllocator<Color>>;
+
+    Width width_;
+    Height height_;
+    Shade intensity_{ defaultIntensity };
+    size_t stride_;
 
-    std::vector<Color> pixels_;
+    imageUtils::PixelBuffer<Color> pixels_;
 
 
     /// The color black in shade of gray
@@ -1015,7 +2154,18 @@ private:
     /// \exception invalidIntensity if the given intensity is outside [0;maxShades]
     /// \exception invalidSizeArray if the given vector don't have the good size like vector_size == width * height
     /// \exception badValuePixel if a pixel in the given vector, have a value above the intensity
-    ColorImage( intmax_t width, intmax_t height, intmax_t intensity, std::vector<Color>&& pixels );
+    ColorImage( intmax_t width, intmax_t height, intmax_t intensity, Pixels&& pixels );
+
+    /// Build a color Image like ColorImage( width, height, intensity, Pixels&& ), where each row of the vector holds stride pixels
+    /// \pre The given vector of pixels needs to have it size equal to stride * height
+    /// \note With VERIFIED::YES, the pixels come from the library and are not verified
+    /// \exception invalidLength if the given stride is less than the width
+    ColorImage( intmax_t width, intmax_t height, intmax_t intensity, size_t stride, Pixels&& pixels,
+                imageUtils::VERIFIED verified = imageUtils::VERIFIED::NO );
+
+    /// Created the image of the interleaved shades of the given planes, where each row holds stride pixels
+    /// \exception invalidLength if the given stride is less than the width of the planes
+    static ColorImage* fromPlanes( const ColorPlanes& planes, size_t stride );
 
     /// Build a ColorImage with the given width, height and intensity
     /// The built image was colored with the default Color
@@ -1032,11 +2182,379 @@ private:
     /// \exception std::bad_alloc if the memory allocation fails
     static std::unique_ptr<ColorImage> createColorImage( intmax_t width, intmax_t height, intmax_t intensity );
 
+    /// Read the pixels of a PPM image in the given image, already shaped to the header, P6 if binary, P3 otherwise
+    /// \exception invalidShade if a read shade is above the intensity of the image
+    /// \exception invalidSizeRepresentationPixel if the end of stream was reached before reading all pixels
+    /// \exception alwaysData if the stream always contains data after the pixels
+    static void readPPMPixels( std::istream& is, bool binary, ColorImage& image );
+
+    /// Compress the pixels of the given view with the given compressor, its destination needs to be set
+    static void compressJPEG( ConstView view, jpeg_compress_struct& cinfo, int quality );
+
+    /// Decompress an image with the given decompressor, its source needs to be set
+    /// The image is sized to newWidth and newHeight, or keeps its size if both are equal to 0
+    /// \warning You have the responsibility to manage and delete the created image
+    static ColorImage* decompressJPEG( jpeg_decompress_struct& cinfo, intmax_t newWidth, intmax_t newHeight );
+
     /// This method is use in the method line
     /// Just apply Behensam to draw line
     void Behensem2Octants( intmax_t x1, intmax_t y1, intmax_t x2, intmax_t y2, Color color );
 };
 
+/// Image of pixels of type TPixel, where each sample is an unsigned integer of 8 or 16 bits, read and written in PNM
+/// It is instantiated for the four types of pixels : Gray8, Gray16, RGB8 and RGB16
+/// The rows of the image are stored like the rows of GrayImage and ColorImage, and seen through the same views
+/// \note It is not the base of GrayImage and ColorImage, who keep their own processing : it only stores the images
+///       of 16 bits, and shares with them the views, the buffers, the header reader and writer of the PNM files
+/// \warning The gray images can only be read or write in PGM, the color images in PPM
+/// \warning The samples are coded on two bytes in the files, only if the intensity is above 255
+template <typename TPixel>
+class Image {
+public:
+    using Pixel = TPixel;
+
+    /// Type of a sample of a pixel, and of the intensity
+    using Sample = typename imageUtils::PixelTraits<TPixel>::Sample;
+
+    using View = imageUtils::ImageView<TPixel>;
+    using ConstView = imageUtils::ImageView<const TPixel>;
+
+    /// \warning Can't build an image without giving width, height and intensity
+    Image() = delete;
+
+    /// Build an image with the given width, height and intensity, filled with black
+    /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+    /// \exception invalidHeight if the given height is outside ]0; maxHeight]
+    /// \exception invalidIntensity if the given intensity is outside ]0; maximum of Sample]
+    /// \exception std::bad_alloc if the memory allocation fails
+    Image( intmax_t width, intmax_t height, intmax_t intensity );
+
+    /// Build an image like Image( width, height, intensity ), where each row holds stride pixels
+    /// \exception invalidLength if the given stride is less than the width
+    Image( intmax_t width, intmax_t height, intmax_t intensity, size_t stride );
+
+    Image( const Image& ) = default;
+    Image( Image&& ) noexcept = default;
+
+    ~Image() noexcept = default;
+
+    Image& operator=( const Image& ) = default;
+    Image& operator=( Image&& ) noexcept = default;
+
+    Width width() const noexcept;
+    Height height() const noexcept;
+    Sample intensity() const noexcept;
+
+    /// \return The number of pixels between the start of two rows
+    size_t stride() const noexcept;
+
+    /// \return A reference of the pixel at the position x,y
+    /// \exception invalidCoordinateX if x is outside [0; width[
+    /// \exception invalidCoordinateY if y is outside [0; height[
+    /// \warning Don't verify the value affected in the selected pixel
+    TPixel& pixel( intmax_t x, intmax_t y );
+    const TPixel& pixel( intmax_t x, intmax_t y ) const;
+
+    View view();
+    ConstView view() const;
+
+    /// \exception Same as ImageView::region
+    View view( imageUtils::Point start, imageUtils::Dimension<> dim );
+    ConstView view( imageUtils::Point start, imageUtils::Dimension<> dim ) const;
+
+    /// Write in the given output stream the image in PGM (gray) or PPM (color), in the given format {ASCII or BINARY}
+    /// \note In BINARY, the samples are written on two bytes, most significant first, if the intensity is above 255
+    /// \exception invalidFormat if the given format is not ASCII or BINARY
+    void writePNM( std::ostream& os, Format::WRITE_IN f ) const;
+
+    /// Read the given input stream, in P2 or P5 for a gray image, in P3 or P6 for a color image
+    /// \exception invalidType if the magic number does not match with the type of pixel
+    /// \exception invalidIntensity if the intensity is outside ]0; maximum of Sample]
+    /// \exception invalidShade if a sample is above the intensity
+    /// \exception invalidSizeRepresentationPixel if the end of stream was reached before reading all pixels
+    /// \exception alwaysData if the stream always contains data after the pixels
+    /// \exception std::bad_alloc if the memory allocation fails
+    static std::unique_ptr<Image> readPNM( std::istream& is );
+
+private:
+    using Pixels = std::vector<TPixel, imageUtils::AlignedAllocator<TPixel>>;
+
+    static constexpr size_t channels = imageUtils::PixelTraits<TPixel>::channels;
+
+    Width width_;
+    Height height_;
+    Sample intensity_;
+    size_t stride_;
+
+    imageUtils::PixelBuffer<TPixel> pixels_;
+
+    /// Build an image with the given pixels, where each row holds stride pixels
+    /// \pre The samples of the pixels are in [0; intensity]
+    /// \exception invalidSizeArray if the size of pixels is not stride * height
+    Image( intmax_t width, intmax_t height, intmax_t intensity, size_t stride, Pixels&& pixels );
+};
+
+/// Gray pixels on one byte, like the shades of GrayImage
+using Gray8 = Shade;
+
+/// Gray pixels on two bytes
+using Gray16 = uint16_t;
+
+/// Color pixels on three bytes, like the pixels of ColorImage
+using RGB8 = Color;
+
+/// Color pixels on six bytes
+using RGB16 = Color16;
+
+using Gray8Image = Image<Gray8>;
+using Gray16Image = Image<Gray16>;
+using RGB8Image = Image<RGB8>;
+using RGB16Image = Image<RGB16>;
+
+/// Image of pixels of type TPixel, stored by square tiles of tileSize * tileSize pixels, row of tiles after row of tiles
+/// Inside a tile, the pixels are stored row after row, so a column of a tile is in a few pages, not in one page by row
+/// Each tile is seen as a view of stride tileSize, so the 2D operations on the views work tile by tile
+/// \note The rows of the image are linearised only by copyTo, at the time of writing the image
+/// \note The tiles of the last column and of the last row hold the same number of pixels, a part of them is unused
+template <typename TPixel>
+class TiledImage {
+public:
+    using Pixel = TPixel;
+
+    /// Type of a sample of a pixel, and of the intensity
+    using Sample = typename imageUtils::PixelTraits<TPixel>::Sample;
+
+    using View = imageUtils::ImageView<TPixel>;
+    using ConstView = imageUtils::ImageView<const TPixel>;
+
+    /// Number of pixels of a side of a tile
+    static constexpr size_t tileSize = 64;
+
+    /// \warning Can't build an image without giving width, height and intensity
+    TiledImage() = delete;
+
+    /// Build a tiled image with the given width, height and intensity, filled with black
+    /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+    /// \exception invalidHeight if the given height is outside ]0; maxHeight]
+    /// \exception invalidIntensity if the given intensity is outside ]0; maximum of Sample]
+    /// \exception std::bad_alloc if the memory allocation fails
+    TiledImage( intmax_t width, intmax_t height, intmax_t intensity );
+
+    /// Build a tiled image with the pixels and the intensity of the given view, copied tile by tile
+    /// \exception std::bad_alloc if the memory allocation fails
+    explicit TiledImage( ConstView view );
+
+    TiledImage( const TiledImage& ) = default;
+    TiledImage( TiledImage&& ) noexcept = default;
+
+    ~TiledImage() noexcept = default;
+
+    TiledImage& operator=( const TiledImage& ) = default;
+    TiledImage& operator=( TiledImage&& ) noexcept = default;
+
+    Width width() const noexcept;
+    Height height() const noexcept;
+    Sample intensity() const noexcept;
+
+    /// \return The number of tiles on a row of tiles
+    size_t tilesX() const noexcept;
+
+    /// \return The number of tiles on a column of tiles
+    size_t tilesY() const noexcept;
+
+    /// \return The view on the tile at the column of tiles tx and the row of tiles ty
+    /// \note The tiles of the last column or of the last row can be narrower or lower than tileSize
+    /// \exception invalidCoordinateX if tx is outside [0; tilesX[
+    /// \exception invalidCoordinateY if ty is outside [0; tilesY[
+    View tile( size_t tx, size_t ty );
+    ConstView tile( size_t tx, size_t ty ) const;
+
+    /// \return A reference of the pixel at the position x,y
+    /// \exception invalidCoordinateX if x is outside [0; width[
+    /// \exception invalidCoordinateY if y is outside [0; height[
+    /// \warning Don't verify the value affected in the selected pixel
+    TPixel& pixel( intmax_t x, intmax_t y );
+    const TPixel& pixel( intmax_t x, intmax_t y ) const;
+
+    /// Call function( tile, origin ) on each tile, row of tiles after row of tiles
+    /// origin is the position in the image of the first pixel of the tile
+    template <typename TFunction>
+    void forEachTile( TFunction function );
+
+    template <typename TFunction>
+    void forEachTile( TFunction function ) const;
+
+    /// Fill the image with the given pixel, tile by tile
+    /// \exception invalidShade if a sample of the pixel is above the intensity
+    void fill( const TPixel& pixel );
+
+    /// Draw a vertical line of length pixels from the position x,y to the bottom, tile by tile
+    /// \exception invalidCoordinateX if x is outside [0; width[
+    /// \exception invalidCoordinateY if y is outside [0; height[
+    /// \exception invalidLength if length is outside [0; height - y]
+    /// \exception invalidShade if a sample of the pixel is above the intensity
+    void verticalLine( intmax_t x, intmax_t y, intmax_t length, const TPixel& pixel );
+
+    /// Linearise the rows of the rectangle who starts at start, with the dimension of the given view, in the view
+    /// So an image can be written band by band, in a buffer of a few rows given to a RowWriter
+    /// \exception Same as ImageView::region, for the rectangle in the tiled image
+    void copyTo( View view, imageUtils::Point start ) const;
+
+    /// Linearise all the rows of the image in the given view, like copyTo( view, Point{ 0, 0 } )
+    /// \exception invalidWidth if the width of the view is not the width of the image
+    /// \exception invalidHeight if the height of the view is not the height of the image
+    void copyTo( View view ) const;
+
+private:
+    using Pixels = std::vector<TPixel, imageUtils::AlignedAllocator<TPixel>>;
+
+    Width width_;
+    Height height_;
+    Sample intensity_;
+
+    size_t tilesX_;
+    size_t tilesY_;
+
+    Pixels pixels_;
+
+    /// \return The first pixel of the tile tx, ty
+    /// \warning tx and ty are not verified
+    TPixel* tileData( size_t tx, size_t ty ) noexcept;
+    const TPixel* tileData( size_t tx, size_t ty ) const noexcept;
+
+    /// \return The view on the tile tx, ty
+    /// \warning tx and ty are not verified
+    View tileView( size_t tx, size_t ty ) noexcept;
+    ConstView tileView( size_t tx, size_t ty ) const noexcept;
+};
+
+// Avant C++17, le membre statique constexpr utilisé par référence doit être défini
+template <typename TPixel>
+constexpr size_t TiledImage<TPixel>::tileSize;
+
+using Gray8TiledImage = TiledImage<Gray8>;
+using Gray16TiledImage = TiledImage<Gray16>;
+using RGB8TiledImage = TiledImage<RGB8>;
+using RGB16TiledImage = TiledImage<RGB16>;
+
+/// Read an image by bands of rows, from the top to the bottom, without holding the whole image in memory
+/// The shades of the read pixels are in [0, intensity], the gray images are read with three equal shades
+class RowReader {
+public:
+    RowReader( const RowReader& ) = delete;
+    RowReader& operator=( const RowReader& ) = delete;
+
+    virtual ~RowReader() noexcept = default;
+
+    Width width() const noexcept;
+    Height height() const noexcept;
+    Shade intensity() const noexcept;
+
+    /// \returns The number of rows not yet read
+    size_t remainingRows() const noexcept;
+
+    /// Read the next rows of the image in the given buffer, at most count rows of width pixels
+    /// \returns The number of read rows, less than count for the last band, 0 when all rows were read
+    /// \exception invalidSizeRepresentationPixel if the END OF STREAM was encountered before the end of the rows
+    /// \exception invalidShade if a read shade is above the intensity
+    size_t readRows( Color* rows, size_t count );
+
+    /// Open the image in the format PNM (P2, P3, P5 or P6) of the given stream, and read its header
+    /// \note The data after the last row are not read
+    /// \exception invalidType if the type of format don't match with "P2", "P3", "P5" or "P6"
+    /// \exception invalidWidth if the width in the stream was not in ]0, maxWidth]
+    /// \exception invalidHeight if the height in the stream was not in ]0; maxHeight]
+    /// \exception invalidIntensity if the intensity in the stream was not in [0, maxIntensity]
+    static std::unique_ptr<RowReader> openPNM( std::istream& is );
+
+    /// Open the image in the format TARGA (1, 2, 3, 9, 10 or 11) of the given stream, and read its header
+    /// \warning If the origin of the image is at the bottom, the stream needs to be seekable to read the image by bands
+    /// \warning In RLE with the origin at the bottom, the stream is read once to find where each row starts
+    /// \exception invalidFormat if the format or the size of the pixels is not supported
+    /// \exception invalidColorMapType if the color map is not valid
+    static std::unique_ptr<RowReader> openTGA( std::istream& is );
+
+    /// Open the image in the format JPEG of the given stream, and read its header
+    /// \warning The input stream is read by big blocks, so data after the end of the JPEG image can be consumed
+    /// \exception invalidJPEG if the JPEG library reports an error, here or while the rows are read
+    static std::unique_ptr<RowReader> openJPEG( std::istream& is );
+
+protected:
+    /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+    /// \exception invalidHeight if the given height is outside ]0;maxHeight]
+    RowReader( intmax_t width, intmax_t height, Shade intensity );
+
+    /// Read the count rows who start at the row first, in the given buffer
+    /// \pre The rows are read in order, and first + count <= height
+    virtual void decodeRows( Color* rows, size_t first, size_t count ) = 0;
+
+private:
+    const Width width_;
+    const Height height_;
+    const Shade intensity_;
+
+    size_t next_ = 0;
+};
+
+/// Write an image by bands of rows, from the top to the bottom, without holding the whole image in memory
+class RowWriter {
+public:
+    RowWriter( const RowWriter& ) = delete;
+    RowWriter& operator=( const RowWriter& ) = delete;
+
+    virtual ~RowWriter() noexcept = default;
+
+    Width width() const noexcept;
+    Height height() const noexcept;
+
+    /// Write the next count rows of width pixels of the given buffer
+    /// \exception invalidSizeRepresentationPixel if the rows go beyond the height of the image
+    void writeRows( const Color* rows, size_t count );
+
+    /// Write the end of the image, after its last row
+    /// \exception invalidSizeRepresentationPixel if all the rows of the image were not written
+    void finish();
+
+    /// Copy all the remaining rows of the given reader, band by band in the given buffer of bufferRows rows, and finish
+    /// \pre The reader and the writer have the same width and the same height
+    /// \pre The buffer holds bufferRows * width pixels, bufferRows > 0
+    /// \exception invalidSizeArray if the reader and the writer don't have the same width, or bufferRows is 0
+    void copyFrom( RowReader& reader, Color* buffer, size_t bufferRows );
+
+    /// Create a writer of an image in the format PNM, P6 with BINARY or P3 with ASCII, and write its header
+    /// \pre The written shades need to be in [0, intensity]
+    /// \exception invalidFormat if the format is not BINARY or ASCII
+    static std::unique_ptr<RowWriter> createPNM( std::ostream& os, intmax_t width, intmax_t height, Shade intensity,
+                                                 Format::WRITE_IN f );
+
+    /// Create a writer of an image in the format TARGA on 24 bits, with or without RLE, and write its header
+    /// \note The origin of the written image is at the top, so the rows are written in order
+    /// \exception invalidEnumTYPE if the format is not RLE or NO_RLE
+    static std::unique_ptr<RowWriter> createTGA( std::ostream& os, intmax_t width, intmax_t height, Format::WRITE_IN f );
+
+    /// Create a writer of an image in the format JPEG, with the given quality
+    /// \pre The quality needs to be in [0; 100]
+    /// \exception invalidJPEG if the JPEG library reports an error, here or while the rows are written
+    static std::unique_ptr<RowWriter> createJPEG( std::ostream& os, intmax_t width, intmax_t height, int quality );
+
+protected:
+    /// \exception invalidWidth if the given width is outside ]0; maxWidth]
+    /// \exception invalidHeight if the given height is outside ]0;maxHeight]
+    RowWriter( intmax_t width, intmax_t height );
+
+    /// Write the given count rows
+    virtual void encodeRows( const Color* rows, size_t count ) = 0;
+
+    /// Write the end of the image
+    virtual void encodeEnd() = 0;
+
+private:
+    const Width width_;
+    const Height height_;
+
+    size_t next_ = 0;
+};
+
 // BETA
 inline void ColorImage::line( const intmax_t x1, const intmax_t y1,
                               const intmax_t x2, const intmax_t y2, const Color color ) {
@@ -1095,6 +2613,25 @@ inline GrayImage* GrayImage::readPGM( std::istream& is ) {
 // Getters
 inline Width GrayImage::width() const noexcept { return dimension.width; }
 inline Height GrayImage::height() const noexcept { return dimension.height; }
+inline size_t GrayImage::stride() const noexcept { return stride_; }
+
+// Views
+inline GrayImage::View GrayImage::view() {
+    return View( pixels_.data(), dimension.width, dimension.height, stride_, intensity_ );
+}
+
+inline GrayImage::ConstView GrayImage::view() const {
+    return ConstView( pixels_.data(), dimension.width, dimension.height, stride_, intensity_ );
+}
+
+inline GrayImage::View GrayImage::view( const imageUtils::Point start, const imageUtils::Dimension<> dim ) {
+    return view().region( start, dim );
+}
+
+inline GrayImage::ConstView
+GrayImage::view( const imageUtils::Point start, const imageUtils::Dimension<> dim ) const {
+    return view().region( start, dim );
+}
 
 
 // Fillers
@@ -1121,8 +2658,24 @@ inline void GrayImage::drawRectangle(
 // Writers
 inline void GrayImage::writePGM( std::ostream& os ) const { writePGM( os, Format::WRITE_IN::BINARY ); }
 
+inline void GrayImage::writeJPEG( const char* const output ) const { writeJPEG( output, defaultJPEGQuality ); }
+
+inline void GrayImage::writeJPEG( std::ostream& os ) const { writeJPEG( os, defaultJPEGQuality ); }
+
 inline void ColorImage::writeJPEG( const char* const output ) const { writeJPEG( output, defaultJPEGQuality ); }
 
+inline void ColorImage::writeJPEG( std::ostream& os ) const { writeJPEG( os, defaultJPEGQuality ); }
+
+inline void ColorImage::writeJPEG( std::vector<uint8_t>& output ) const { writeJPEG( output, defaultJPEGQuality ); }
+
+inline ColorImage* ColorImage::readJPEG( const char* const input ) { return readJPEG( input, 0, 0 ); }
+
+inline ColorImage* ColorImage::readJPEG( std::istream& is ) { return readJPEG( is, 0, 0 ); }
+
+inline ColorImage* ColorImage::readJPEG( const uint8_t* const data, const size_t size ) {
+    return readJPEG( data, size, 0, 0 );
+}
+
 
 
 // ColorImage's methods
@@ -1130,6 +2683,25 @@ inline void ColorImage::writeJPEG( const char* const output ) const { writeJPEG(
 // Getters
 inline const Width& ColorImage::getWidth() const noexcept { return width_; }
 inline const Height& ColorImage::getHeight() const noexcept { return height_; }
+inline size_t ColorImage::stride() const noexcept { return stride_; }
+
+// Views
+inline ColorImage::View ColorImage::view() {
+    return View( pixels_.data(), width_, height_, stride_, intensity_ );
+}
+
+inline ColorImage::ConstView ColorImage::view() const {
+    return ConstView( pixels_.data(), width_, height_, stride_, intensity_ );
+}
+
+inline ColorImage::View ColorImage::view( const imageUtils::Point start, const imageUtils::Dimension<> dim ) {
+    return view().region( start, dim );
+}
+
+inline ColorImage::ConstView
+ColorImage::view( const imageUtils::Point start, const imageUtils::Dimension<> dim ) const {
+    return view().region( start, dim );
+}
 
 // Fillers
 inline void ColorImage::clear() { fill( defaultColor ); }
@@ -1169,5 +2741,152 @@ ColorImage::createColorImage( const intmax_t width, const intmax_t height, const
     return std::make_unique<ColorImage>( width, height, intensity );
 }
 
+// ColorPlanes's methods
+inline Width ColorPlanes::width() const noexcept { return width_; }
+
+inline Height ColorPlanes::height() const noexcept { return height_; }
+
+inline Shade ColorPlanes::intensity() const noexcept { return intensity_; }
+
+inline Shade* ColorPlanes::plane( const size_t index ) noexcept {
+    return shades_.data() + ( index * width_ * height_ );
+}
+
+inline const Shade* ColorPlanes::plane( const size_t index ) const noexcept {
+    return shades_.data() + ( index * width_ * height_ );
+}
+
+inline ColorPlanes::View ColorPlanes::red() { return View( plane( 0 ), width_, height_, width_, intensity_ ); }
+
+inline ColorPlanes::ConstView ColorPlanes::red() const {
+    return ConstView( plane( 0 ), width_, height_, width_, intensity_ );
+}
+
+inline ColorPlanes::View ColorPlanes::green() { return View( plane( 1 ), width_, height_, width_, intensity_ ); }
+
+inline ColorPlanes::ConstView ColorPlanes::green() const {
+    return ConstView( plane( 1 ), width_, height_, width_, intensity_ );
+}
+
+inline ColorPlanes::View ColorPlanes::blue() { return View( plane( 2 ), width_, height_, width_, intensity_ ); }
+
+inline ColorPlanes::ConstView ColorPlanes::blue() const {
+    return ConstView( plane( 2 ), width_, height_, width_, intensity_ );
+}
+
+inline ColorPlanes ColorImage::planes() const { return planes( view() ); }
+
+// Image's methods
+template <typename TPixel>
+inline Width Image<TPixel>::width() const noexcept { return width_; }
+
+template <typename TPixel>
+inline Height Image<TPixel>::height() const noexcept { return height_; }
+
+template <typename TPixel>
+inline typename Image<TPixel>::Sample Image<TPixel>::intensity() const noexcept { return intensity_; }
+
+template <typename TPixel>
+inline size_t Image<TPixel>::stride() const noexcept { return stride_; }
+
+template <typename TPixel>
+inline typename Image<TPixel>::View Image<TPixel>::view() {
+    return View( pixels_.data(), width_, height_, stride_, intensity_ );
+}
+
+template <typename TPixel>
+inline typename Image<TPixel>::ConstView Image<TPixel>::view() const {
+    return ConstView( pixels_.data(), width_, height_, stride_, intensity_ );
+}
+
+template <typename TPixel>
+inline typename Image<TPixel>::View
+Image<TPixel>::view( const imageUtils::Point start, const imageUtils::Dimension<> dim ) {
+    return view().region( start, dim );
+}
+
+template <typename TPixel>
+inline typename Image<TPixel>::ConstView
+Image<TPixel>::view( const imageUtils::Point start, const imageUtils::Dimension<> dim ) const {
+    return view().region( start, dim );
+}
+
+template <typename TPixel>
+inline TPixel& Image<TPixel>::pixel( const intmax_t x, const intmax_t y ) { return view().pixel( x, y ); }
+
+template <typename TPixel>
+inline const TPixel& Image<TPixel>::pixel( const intmax_t x, const intmax_t y ) const { return view().pixel( x, y ); }
+
+// TiledImage's methods
+template <typename TPixel>
+inline Width TiledImage<TPixel>::width() const noexcept { return width_; }
+
+template <typename TPixel>
+inline Height TiledImage<TPixel>::height() const noexcept { return height_; }
+
+template <typename TPixel>
+inline typename TiledImage<TPixel>::Sample TiledImage<TPixel>::intensity() const noexcept { return intensity_; }
+
+template <typename TPixel>
+inline size_t TiledImage<TPixel>::tilesX() const noexcept { return tilesX_; }
+
+template <typename TPixel>
+inline size_t TiledImage<TPixel>::tilesY() const noexcept { return tilesY_; }
+
+template <typename TPixel>
+inline TPixel* TiledImage<TPixel>::tileData( const size_t tx, const size_t ty ) noexcept {
+    return pixels_.data() + ( ( ( ty * tilesX_ ) + tx ) * tileSize * tileSize );
+}
+
+template <typename TPixel>
+inline const TPixel* TiledImage<TPixel>::tileData( const size_t tx, const size_t ty ) const noexcept {
+    return pixels_.data() + ( ( ( ty * tilesX_ ) + tx ) * tileSize * tileSize );
+}
+
+template <typename TPixel>
+inline typename TiledImage<TPixel>::View TiledImage<TPixel>::tileView( const size_t tx, const size_t ty ) noexcept {
+    // Les tuiles de la dernière colonne et de la dernière ligne ne sont vues que sur la partie dans l'image
+    return View( tileData( tx, ty ), std::min( tileSize, width_ - ( tx * tileSize ) ),
+                 std::min( tileSize, height_ - ( ty * tileSize ) ), tileSize, intensity_ );
+}
+
+template <typename TPixel>
+inline typename TiledImage<TPixel>::ConstView
+TiledImage<TPixel>::tileView( const size_t tx, const size_t ty ) const noexcept {
+    return ConstView( tileData( tx, ty ), std::min( tileSize, width_ - ( tx * tileSize ) ),
+                      std::min( tileSize, height_ - ( ty * tileSize ) ), tileSize, intensity_ );
+}
+
+template <typename TPixel>
+template <typename TFunction>
+inline void TiledImage<TPixel>::forEachTile( TFunction function ) {
+    for ( size_t ty = 0; ty < tilesY_; ++ty ) {
+        for ( size_t tx = 0; tx < tilesX_; ++tx ) {
+            function( tileView( tx, ty ), imageUtils::Point{ static_cast<intmax_t>(tx * tileSize),
+                                                             static_cast<intmax_t>(ty * tileSize) } );
+        }
+    }
+}
+
+template <typename TPixel>
+template <typename TFunction>
+inline void TiledImage<TPixel>::forEachTile( TFunction function ) const {
+    for ( size_t ty = 0; ty < tilesY_; ++ty ) {
+        for ( size_t tx = 0; tx < tilesX_; ++tx ) {
+            function( tileView( tx, ty ), imageUtils::Point{ static_cast<intmax_t>(tx * tileSize),
+                                                             static_cast<intmax_t>(ty * tileSize) } );
+        }
+    }
+}
+
+// RowReader's and RowWriter's methods
+inline Width RowReader::width() const noexcept { return width_; }
+inline Height RowReader::height() const noexcept { return height_; }
+inline Shade RowReader::intensity() const noexcept { return intensity_; }
+inline size_t RowReader::remainingRows() const noexcept { return height_ - next_; }
+
+inline Width RowWriter::width() const noexcept { return width_; }
+inline Height RowWriter::height() const noexcept { return height_; }
+
 
 #endif // DAVID_A_IMAGE_HPP
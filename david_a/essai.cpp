@@ -18,6 +18,19 @@ using namespace std;
 extern const char * const identifier;   // Ne pas modifier ces deux lignes ! Vos changements au sujet
 extern const char * const informations; // de ceux deux constantes doivent être faits dans Image.cpp.
 
+// Ecrit l'image en TARGA dans le format donné, la relit, et compare les pixels des deux images
+static bool sameAfterTGA(const ColorImage& image, Format::WRITE_IN f)
+{
+ stringstream tga;
+ image.writeTGA(tga, f);
+ unique_ptr<ColorImage> read(ColorImage::readTGA(tga));
+
+ ostringstream expected, obtained;
+ image.writePPM(expected);
+ read->writePPM(obtained);
+ return expected.str() == obtained.str();
+}
+
 
 int main(int argc,char *argv[])
 {
@@ -25,6 +38,90 @@ int main(int argc,char *argv[])
  cout << "Les informations que vous avez decide d'indiquer au correcteur : " << endl << informations << endl;
  try
   {
+   // Une image JPEG corrompue doit lever une exception, et non arrêter le programme
+   const uint8_t corrupt[20] = { 0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 'J', 'F', 'I', 'F',
+                                 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0xFF, 0xDA };
+   try
+    {
+     delete ColorImage::readJPEG( corrupt, sizeof( corrupt ) );
+     cerr << "Erreur : le JPEG corrompu a ete lu" << endl;
+    }
+   catch(runtime_error& e)
+    { cout << "JPEG corrompu refuse : " << e.what() << endl; }
+
+   // De même pour la décompression réduite, depuis un flux
+   try
+    {
+     istringstream corruptStream( string( reinterpret_cast<const char*>( corrupt ), sizeof( corrupt ) ) );
+     delete ColorImage::readJPEG( corruptStream, 8, 8 );
+     cerr << "Erreur : le JPEG corrompu a ete reduit" << endl;
+    }
+   catch(runtime_error& e)
+    { cout << "JPEG corrompu refuse a la reduction : " << e.what() << endl; }
+
+   // Et pour la décompression en niveaux de gris
+   try
+    {
+     istringstream corruptStream( string( reinterpret_cast<const char*>( corrupt ), sizeof( corrupt ) ) );
+     GrayImage::readJPEG( corruptStream );
+     cerr << "Erreur : le JPEG corrompu a ete lu en gris" << endl;
+    }
+   catch(runtime_error& e)
+    { cout << "JPEG corrompu refuse en gris : " << e.what() << endl; }
+
+   // Et pour la lecture par bandes
+   try
+    {
+     istringstream corruptStream( string( reinterpret_cast<const char*>( corrupt ), sizeof( corrupt ) ) );
+     RowReader::openJPEG( corruptStream );
+     cerr << "Erreur : le JPEG corrompu a ete ouvert par bandes" << endl;
+    }
+   catch(runtime_error& e)
+    { cout << "JPEG corrompu refuse par bandes : " << e.what() << endl; }
+
+   // Les zéros de tête sont lus en entier, comme avec l'opérateur >>
+   istringstream leadingZeros( "P2\n2 1\n255\n000000000007 5\n" );
+   auto zeros = GrayImage::readPGM( leadingZeros );
+   if ( ( 7 != zeros->pixel( 0, 0 ) ) || ( 5 != zeros->pixel( 1, 0 ) ) )
+     cerr << "Erreur : les zeros de tete ont coupe la valeur" << endl;
+   delete zeros;
+
+   // Une valeur trop longue est refusée, au lieu d'être coupée en deux valeurs
+   try
+    {
+     istringstream tooLong( "P2\n2 1\n255\n99999999999999999999 5\n" );
+     delete GrayImage::readPGM( tooLong );
+     cerr << "Erreur : la valeur trop longue a ete lue" << endl;
+    }
+   catch(invalid_argument& e)
+    { cout << "Valeur trop longue refusee : " << e.what() << endl; }
+
+   // Le codage RLE compare six pixels à la fois : les largeurs autour de cette limite sont relues
+   for ( const int width : { 6, 7, 12 } )
+    {
+     ColorImage rle(width, 2, 255);
+     for ( int x = 0; x < width; ++x )
+      {
+       // Une suite de pixels égaux, puis des pixels tous différents
+       rle.pixel(x, 0) = ( x < width / 2 ) ? Color(10, 20, 30) : Color(x, 2 * x, 3 * x);
+       rle.pixel(x, 1) = Color(x, 255 - x, x / 2);
+      }
+     if ( !sameAfterTGA(rle, Format::WRITE_IN::RLE) )
+       cerr << "Erreur : l'image de largeur " << width << " differe apres un TARGA RLE" << endl;
+    }
+
+   // Les images TARGA de référence, relues après une écriture avec et sans RLE
+   for ( const char* name : { "../ressources/images/chat.tga", "../ressources/images/palette_bl.tga",
+                              "../ressources/images/palette_tl.tga" } )
+    {
+     ifstream input(name, ios::binary);
+     unique_ptr<ColorImage> reference(ColorImage::readTGA(input));
+     if ( !sameAfterTGA(*reference, Format::WRITE_IN::RLE) )
+       cerr << "Erreur : " << name << " differe apres un TARGA RLE" << endl;
+     if ( !sameAfterTGA(*reference, Format::WRITE_IN::NO_RLE) )
+       cerr << "Erreur : " << name << " differe apres un TARGA sans RLE" << endl;
+    }
+
    ifstream inputana( "../ressources/ombres.ppm", ios::binary);
    auto ana = ColorImage::readPPM(inputana);
    auto anargb = ana->anaglyphe();